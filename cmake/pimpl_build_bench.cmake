@@ -0,0 +1,116 @@
+# Measures what the item22 pimpl firewall buys at build time.
+#
+# Two throwaway projects are generated under BENCH_DIR, each with TU_COUNT translation units that create
+# a Widget:
+#   pimpl : the TUs include item22_widget.h, only the implementation TU includes item22_gadget.h
+#   plain : the TUs include a Widget that holds string, small_vector<double, 4> and three Gadgets directly
+# Both are built from scratch, then item22_gadget.h is edited and both are rebuilt incrementally.
+#
+# Usually run through the pimpl_build_bench target; stand-alone:
+#   cmake -DSOURCE_DIR=<repo> -DBENCH_DIR=<dir> [-DTU_COUNT=200] [-DJOBS=8] -P cmake/pimpl_build_bench.cmake
+
+if(NOT SOURCE_DIR OR NOT BENCH_DIR)
+	message(FATAL_ERROR "pimpl_build_bench: SOURCE_DIR and BENCH_DIR are required")
+endif()
+if(NOT TU_COUNT)
+	set(TU_COUNT 200)
+endif()
+
+# Microsecond timestamps need CMake 3.23, older versions fall back to whole seconds.
+if(CMAKE_VERSION VERSION_LESS 3.23)
+	set(_stamp_format "%s")
+	set(_stamp_scale 1000)
+else()
+	set(_stamp_format "%s%f")
+	set(_stamp_scale 0)
+endif()
+
+function(now_ms out)
+	string(TIMESTAMP t "${_stamp_format}" UTC)
+	if(_stamp_scale)
+		math(EXPR t "${t} * ${_stamp_scale}")
+	else()
+		math(EXPR t "${t} / 1000")
+	endif()
+	set(${out} ${t} PARENT_SCOPE)
+endfunction()
+
+function(timed_build dir out)
+	set(build_args --build ${dir})
+	if(JOBS)
+		list(APPEND build_args --parallel ${JOBS})
+	endif()
+	now_ms(start)
+	execute_process(COMMAND ${CMAKE_COMMAND} ${build_args} RESULT_VARIABLE rv OUTPUT_QUIET)
+	now_ms(stop)
+	if(NOT rv EQUAL 0)
+		message(FATAL_ERROR "pimpl_build_bench: building ${dir} failed")
+	endif()
+	math(EXPR elapsed "${stop} - ${start}")
+	set(${out} ${elapsed} PARENT_SCOPE)
+endfunction()
+
+file(REMOVE_RECURSE ${BENCH_DIR})
+
+foreach(variant pimpl plain)
+	set(src ${BENCH_DIR}/${variant}/src)
+	configure_file(${SOURCE_DIR}/item22_gadget.h ${src}/item22_gadget.h COPYONLY)
+	configure_file(${SOURCE_DIR}/small_vector.hpp ${src}/small_vector.hpp COPYONLY)
+	set(sources "")
+	if(variant STREQUAL "pimpl")
+		configure_file(${SOURCE_DIR}/item22_widget.h ${src}/item22_widget.h COPYONLY)
+		configure_file(${SOURCE_DIR}/item22_widget_impl.cpp ${src}/item22_widget_impl.cpp COPYONLY)
+		set(header item22_widget.h)
+		list(APPEND sources item22_widget_impl.cpp)
+	else()
+		file(WRITE ${src}/plain_widget.h
+			"#pragma once\n#include <iostream>\n#include <string>\n#include \"small_vector.hpp\"\n#include \"item22_gadget.h\"\n\n"
+			"class Widget{\npublic:\n    std::string name;\n    small_vector<double, 4> data;\n    Gadget g1, g2, g3;\n};\n")
+		set(header plain_widget.h)
+	endif()
+	foreach(i RANGE 1 ${TU_COUNT})
+		file(WRITE ${src}/tu_${i}.cpp
+			"#include \"${header}\"\n\nint useWidget${i}(){\n    Widget w;\n    Widget w1(w);\n    return ${i};\n}\n")
+		list(APPEND sources tu_${i}.cpp)
+	endforeach()
+	string(REPLACE ";" " " sources "${sources}")
+	file(WRITE ${src}/CMakeLists.txt
+		"cmake_minimum_required(VERSION 3.6)\nproject(pimpl_build_bench_${variant} CXX)\n"
+		"set(CMAKE_CXX_STANDARD 17)\nadd_library(widgets OBJECT ${sources})\n")
+
+	set(configure_args -S ${src} -B ${BENCH_DIR}/${variant}/build)
+	if(GENERATOR)
+		list(APPEND configure_args -G ${GENERATOR})
+	endif()
+	if(CXX_COMPILER)
+		list(APPEND configure_args -DCMAKE_CXX_COMPILER=${CXX_COMPILER})
+	endif()
+	execute_process(COMMAND ${CMAKE_COMMAND} ${configure_args} RESULT_VARIABLE rv OUTPUT_QUIET)
+	if(NOT rv EQUAL 0)
+		message(FATAL_ERROR "pimpl_build_bench: configuring ${variant} failed")
+	endif()
+
+	timed_build(${BENCH_DIR}/${variant}/build full_${variant})
+	# A real edit, not just a touch, so content-hashing build tools rebuild as well.
+	file(APPEND ${src}/item22_gadget.h "\n// pimpl_build_bench revision\n")
+	timed_build(${BENCH_DIR}/${variant}/build incr_${variant})
+endforeach()
+
+math(EXPR full_diff "${full_plain} - ${full_pimpl}")
+math(EXPR incr_diff "${incr_plain} - ${incr_pimpl}")
+
+function(report_row label)
+	set(line "${label}")
+	foreach(value ${ARGN})
+		string(LENGTH "${value}" len)
+		math(EXPR pad "14 - ${len}")
+		string(SUBSTRING "              " 0 ${pad} spaces)
+		string(APPEND line "${spaces}${value}")
+	endforeach()
+	message("${line}")
+endfunction()
+
+message("pimpl build benchmark, ${TU_COUNT} translation units per variant (ms)")
+report_row("                " pimpl plain "plain - pimpl")
+report_row("  full build    " ${full_pimpl} ${full_plain} ${full_diff})
+report_row("  gadget.h edit " ${incr_pimpl} ${incr_plain} ${incr_diff})
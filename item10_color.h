@@ -0,0 +1,13 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "item10_enum_containers.h"
+
+// Declare underlying type for scoped enum.
+enum class Color:std::uint8_t{
+    black, white, red
+};
+
+/* Color has no _count enumerator, so its size for enum_array, enum_bitset and enumName is given here. */
+template<> struct enum_size<Color> : std::integral_constant<std::size_t, 3>{};
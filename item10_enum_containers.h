@@ -0,0 +1,177 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include "item10_to_em_type.h"
+
+/*
+    Containers indexed by a scoped enum, for the per-state counters and flag sets that would otherwise be
+    a std::map<E, T> or std::set<E>. The enumerator is turned into an index by toEmType, so a lookup is
+    one address computation: no tree walk, no node allocation, no branch, and all values sit contiguously
+    in the object.
+
+    The enumerators must be 0, 1, ..., N-1 (the default for an enum class). N is taken from a sentinel
+    enumerator named _count,
+
+        enum class ConnState{idle, connecting, open, closing, closed, _count};
+
+    or, for enums that cannot grow one, from a specialization of enum_size:
+
+        template<> struct enum_size<Color> : std::integral_constant<std::size_t, 3>{};
+*/
+template<typename E, typename = void>
+struct enum_size{
+    static_assert(std::is_enum<E>::value, "enum_size is for enumerations");
+    static_assert(sizeof(E) == 0, "give the enum a trailing _count enumerator or specialize enum_size for it");
+};
+
+template<typename E>
+struct enum_size<E, std::void_t<decltype(E::_count)>>
+    : std::integral_constant<std::size_t, static_cast<std::size_t>(toEmType(E::_count))>{};
+
+template<typename E>
+inline constexpr std::size_t enum_size_v = enum_size<E>::value;
+
+/* An array with one T per enumerator. An aggregate: enum_array<E, int> a{}; zero-initializes it. */
+template<typename E, typename T>
+struct enum_array{
+    static constexpr std::size_t N = enum_size_v<E>;
+
+    constexpr T& operator[](E e) noexcept { return values[static_cast<std::size_t>(toEmType(e))]; }
+    constexpr const T& operator[](E e) const noexcept { return values[static_cast<std::size_t>(toEmType(e))]; }
+    constexpr T& at(E e){
+        if(static_cast<std::size_t>(toEmType(e)) >= N) throw std::out_of_range("enum_array::at");
+        return (*this)[e];
+    }
+    constexpr const T& at(E e) const{
+        if(static_cast<std::size_t>(toEmType(e)) >= N) throw std::out_of_range("enum_array::at");
+        return (*this)[e];
+    }
+
+    /* the enumerator for position i, e.g. while iterating */
+    static constexpr E key(std::size_t i) noexcept { return static_cast<E>(i); }
+
+    constexpr void fill(const T& value){
+        for(auto& v : values) v = value;
+    }
+
+    static constexpr std::size_t size() noexcept { return N; }
+    constexpr T* data() noexcept { return values.data(); }
+    constexpr const T* data() const noexcept { return values.data(); }
+    constexpr T* begin() noexcept { return values.data(); }
+    constexpr const T* begin() const noexcept { return values.data(); }
+    constexpr T* end() noexcept { return values.data() + N; }
+    constexpr const T* end() const noexcept { return values.data() + N; }
+
+    std::array<T, N> values;
+};
+
+/* One bit per enumerator, packed into 64-bit words. */
+template<typename E>
+class enum_bitset{
+public:
+    static constexpr std::size_t N = enum_size_v<E>;
+
+    constexpr enum_bitset() noexcept = default;
+    constexpr enum_bitset(std::initializer_list<E> init) noexcept{
+        for(E e : init) set(e);
+    }
+
+    constexpr bool test(E e) const noexcept { return (words[word(e)] >> bit(e)) & 1u; }
+    constexpr bool operator[](E e) const noexcept { return test(e); }
+
+    constexpr enum_bitset& set(E e) noexcept{
+        words[word(e)] |= mask(e);
+        return *this;
+    }
+    /* without a branch on value: clear the bit, then or in value's bit */
+    constexpr enum_bitset& set(E e, bool value) noexcept{
+        words[word(e)] = (words[word(e)] & ~mask(e)) | ((std::uint64_t(0) - std::uint64_t(value)) & mask(e));
+        return *this;
+    }
+    constexpr enum_bitset& reset(E e) noexcept{
+        words[word(e)] &= ~mask(e);
+        return *this;
+    }
+    constexpr enum_bitset& flip(E e) noexcept{
+        words[word(e)] ^= mask(e);
+        return *this;
+    }
+    constexpr enum_bitset& set() noexcept{
+        for(std::size_t i = 0; i < wordCount; i++) words[i] = ~std::uint64_t(0);
+        words[wordCount - 1] &= lastWordMask;
+        return *this;
+    }
+    constexpr enum_bitset& reset() noexcept{
+        for(auto& w : words) w = 0;
+        return *this;
+    }
+
+    constexpr std::size_t count() const noexcept{
+        std::size_t n = 0;
+        for(auto w : words) n += static_cast<std::size_t>(__builtin_popcountll(w));
+        return n;
+    }
+    constexpr bool any() const noexcept{
+        std::uint64_t acc = 0;
+        for(auto w : words) acc |= w;
+        return acc != 0;
+    }
+    constexpr bool none() const noexcept { return !any(); }
+    constexpr bool all() const noexcept { return count() == N; }
+    static constexpr std::size_t size() noexcept { return N; }
+
+    /* calls f(e) for every set enumerator, lowest first */
+    template<typename F>
+    constexpr void for_each(F f) const{
+        for(std::size_t i = 0; i < wordCount; i++){
+            for(std::uint64_t w = words[i]; w; w &= w - 1){
+                f(static_cast<E>(i * 64 + static_cast<std::size_t>(__builtin_ctzll(w))));
+            }
+        }
+    }
+
+    constexpr enum_bitset& operator&=(const enum_bitset& rhs) noexcept{
+        for(std::size_t i = 0; i < wordCount; i++) words[i] &= rhs.words[i];
+        return *this;
+    }
+    constexpr enum_bitset& operator|=(const enum_bitset& rhs) noexcept{
+        for(std::size_t i = 0; i < wordCount; i++) words[i] |= rhs.words[i];
+        return *this;
+    }
+    constexpr enum_bitset& operator^=(const enum_bitset& rhs) noexcept{
+        for(std::size_t i = 0; i < wordCount; i++) words[i] ^= rhs.words[i];
+        return *this;
+    }
+    constexpr enum_bitset operator~() const noexcept{
+        enum_bitset result;
+        for(std::size_t i = 0; i < wordCount; i++) result.words[i] = ~words[i];
+        result.words[wordCount - 1] &= lastWordMask;
+        return result;
+    }
+    friend constexpr enum_bitset operator&(enum_bitset lhs, const enum_bitset& rhs) noexcept { return lhs &= rhs; }
+    friend constexpr enum_bitset operator|(enum_bitset lhs, const enum_bitset& rhs) noexcept { return lhs |= rhs; }
+    friend constexpr enum_bitset operator^(enum_bitset lhs, const enum_bitset& rhs) noexcept { return lhs ^= rhs; }
+    friend constexpr bool operator==(const enum_bitset& lhs, const enum_bitset& rhs) noexcept{
+        for(std::size_t i = 0; i < wordCount; i++){
+            if(lhs.words[i] != rhs.words[i]) return false;
+        }
+        return true;
+    }
+    friend constexpr bool operator!=(const enum_bitset& lhs, const enum_bitset& rhs) noexcept { return !(lhs == rhs); }
+
+private:
+    static_assert(N > 0, "enum_bitset needs at least one enumerator");
+    static constexpr std::size_t wordCount = (N + 63) / 64;
+    /* bits of the last word that belong to an enumerator, so ~ and set() leave the rest zero */
+    static constexpr std::uint64_t lastWordMask = N % 64 == 0 ? ~std::uint64_t(0) : (std::uint64_t(1) << (N % 64)) - 1;
+
+    static constexpr std::size_t word(E e) noexcept { return static_cast<std::size_t>(toEmType(e)) / 64; }
+    static constexpr std::size_t bit(E e) noexcept { return static_cast<std::size_t>(toEmType(e)) % 64; }
+    static constexpr std::uint64_t mask(E e) noexcept { return std::uint64_t(1) << bit(e); }
+
+    std::array<std::uint64_t, wordCount> words{};
+};
@@ -0,0 +1,71 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+#include "item10_enum_containers.h"
+#include "item10_color.h"
+
+using namespace std;
+
+/*
+    Per-state counters and state flags: std::map<E, T> and std::set<E> against enum_array and enum_bitset.
+
+    10M random state transitions each bump the counter of the new state and mark it as seen; the totals
+    and the seen sets must agree between the two versions.
+*/
+
+using Clock = std::chrono::steady_clock;
+
+enum class ConnState : std::uint8_t{idle, connecting, handshake, open, draining, closing, closed, failed, _count};
+
+static_assert(enum_array<ConnState, int>::size() == 8 && enum_bitset<Color>::size() == 3, "enum sizes");
+static_assert(sizeof(enum_bitset<ConnState>) == 8, "eight states fit in one word");
+static_assert((~enum_bitset<Color>{Color::red}).count() == 2, "~ leaves bits past the last enumerator clear");
+
+int main(){
+    const size_t transitions = 10000000;
+    mt19937 gen(43);
+    uniform_int_distribution<int> pick(0, enum_size_v<ConnState> - 1);
+    vector<ConnState> states(transitions);
+    for(auto& s : states) s = static_cast<ConnState>(pick(gen));
+
+    map<ConnState, uint64_t> mapCounters;
+    set<ConnState> mapSeen;
+    auto start = Clock::now();
+    for(auto s : states){
+        ++mapCounters[s];
+        mapSeen.insert(s);
+    }
+    double mapNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / transitions;
+
+    enum_array<ConnState, uint64_t> counters{};
+    enum_bitset<ConnState> seen;
+    start = Clock::now();
+    for(auto s : states){
+        ++counters[s];
+        seen.set(s);
+    }
+    double arrayNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / transitions;
+
+    bool same = mapSeen.size() == seen.count();
+    for(size_t i = 0; i < counters.size(); i++){
+        auto e = counters.key(i);
+        same = same && mapCounters[e] == counters[e] && (mapSeen.count(e) == 1) == seen.test(e);
+    }
+
+    cout << fixed << setprecision(1);
+    cout << transitions << " state transitions, ns per transition" << endl;
+    cout << "  std::map + std::set        : " << setw(6) << mapNs << endl;
+    cout << "  enum_array + enum_bitset   : " << setw(6) << arrayNs << "   " << (same ? "same counts" : "MISMATCH") << endl;
+    cout << "  footprint                  : map/set nodes on the heap vs "
+         << sizeof(counters) + sizeof(seen) << " bytes inline" << endl;
+
+    cout << "states seen :";
+    seen.for_each([](ConnState s){ cout << ' ' << static_cast<int>(toEmType(s)); });
+    cout << endl;
+    return same ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include "item10_enum_containers.h"
+
+/*
+    Compile-time names for scoped enums, and parsing back from a name.
+
+    enumName(Color::white) == "white", with no table to write by hand: enumeratorName<E, V>() reads the
+    enumerator's spelling out of __PRETTY_FUNCTION__ (GCC and Clang both print the template argument),
+    and enum_reflection<E> collects those names for the values 0 .. enum_size_v<E> - 1 into a constexpr
+    table. E must be declared at namespace scope so enum_size can be specialized for it when it has no
+    _count enumerator.
+
+    parseEnum<E>(s) looks the name up in a perfect hash built by the compiler: a seed is searched at
+    compile time until FNV-1a(name, seed) puts every name in its own slot, so a lookup is one hash, one
+    slot load and one string compare, with no allocation and no probing.
+*/
+template<typename E, E V>
+constexpr std::string_view enumeratorName() noexcept{
+    std::string_view f = __PRETTY_FUNCTION__;
+    std::size_t start = f.find("V = ");
+    if(start == std::string_view::npos) return {};
+    start += 4;
+    std::size_t end = f.find_first_of(";]", start);
+    std::string_view value = f.substr(start, end - start);
+    /* a value without an enumerator is printed as a cast, e.g. (Color)7 */
+    if(value.empty() || value.front() == '(') return {};
+    std::size_t scope = value.rfind("::");
+    return scope == std::string_view::npos ? value : value.substr(scope + 2);
+}
+
+/* Helpers live outside enum_reflection: a class cannot call its own member functions in the
+   initializers of its static constexpr members, it is still incomplete there. */
+namespace enum_reflection_detail{
+
+constexpr std::uint64_t fnv1a(std::string_view s, std::uint64_t seed) noexcept{
+    std::uint64_t h = 0xCBF29CE484222325ULL ^ seed;
+    for(char c : s){
+        h ^= static_cast<unsigned char>(c);
+        h *= 0x100000001B3ULL;
+    }
+    return h ^ (h >> 29);
+}
+
+template<typename E, std::size_t... I>
+constexpr std::array<std::string_view, sizeof...(I)> makeNames(std::index_sequence<I...>) noexcept{
+    return {{enumeratorName<E, static_cast<E>(I)>()...}};
+}
+
+/* twice as many slots as names, rounded up to a power of two, so a seed is found quickly */
+constexpr std::size_t slotCount(std::size_t n) noexcept{
+    std::size_t m = 1;
+    while(m < 2 * n) m <<= 1;
+    return m;
+}
+
+constexpr std::uint16_t emptySlot = 0xFFFF;
+
+template<std::size_t Slots>
+struct PerfectHash{
+    std::uint64_t seed;
+    std::array<std::uint16_t, Slots> slot;
+};
+
+template<std::size_t Slots, std::size_t N>
+constexpr PerfectHash<Slots> makeHash(const std::array<std::string_view, N>& names) noexcept{
+    for(std::uint64_t seed = 0;; seed++){
+        PerfectHash<Slots> h{seed, {}};
+        for(auto& s : h.slot) s = emptySlot;
+        bool collision = false;
+        for(std::size_t i = 0; i < N && !collision; i++){
+            if(names[i].empty()) continue; // a gap in the values: nothing to parse
+            auto& s = h.slot[fnv1a(names[i], seed) & (Slots - 1)];
+            if(s != emptySlot) collision = true;
+            else s = static_cast<std::uint16_t>(i);
+        }
+        if(!collision) return h;
+    }
+}
+
+} // namespace enum_reflection_detail
+
+template<typename E>
+struct enum_reflection{
+    static constexpr std::size_t N = enum_size_v<E>;
+    static_assert(N < enum_reflection_detail::emptySlot, "enum_reflection supports up to 65534 enumerators");
+
+    static constexpr std::array<std::string_view, N> names =
+        enum_reflection_detail::makeNames<E>(std::make_index_sequence<N>{});
+    static constexpr std::size_t slots = enum_reflection_detail::slotCount(N);
+    static constexpr enum_reflection_detail::PerfectHash<slots> hash =
+        enum_reflection_detail::makeHash<slots>(names);
+};
+
+/* The enumerator's name, or an empty view for a value that has none. */
+template<typename E>
+constexpr std::string_view enumName(E e) noexcept{
+    auto i = static_cast<std::size_t>(toEmType(e));
+    return i < enum_reflection<E>::N ? enum_reflection<E>::names[i] : std::string_view{};
+}
+
+template<typename E>
+constexpr const std::array<std::string_view, enum_size_v<E>>& enumNames() noexcept{
+    return enum_reflection<E>::names;
+}
+
+/* The enumerator spelled exactly as s, if there is one. */
+template<typename E>
+constexpr std::optional<E> parseEnum(std::string_view s) noexcept{
+    using R = enum_reflection<E>;
+    std::uint16_t i = R::hash.slot[enum_reflection_detail::fnv1a(s, R::hash.seed) & (R::slots - 1)];
+    if(i == enum_reflection_detail::emptySlot || R::names[i] != s) return std::nullopt;
+    return static_cast<E>(i);
+}
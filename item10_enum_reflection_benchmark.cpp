@@ -0,0 +1,70 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "item10_color.h"
+#include "item10_enum_reflection.h"
+
+using namespace std;
+
+/*
+    Parsing enum names out of log lines: unordered_map<string, enum> against parseEnum's compile-time
+    perfect hash, over 10M level names (with a few misspelt ones mixed in, which must come back empty).
+*/
+
+using Clock = std::chrono::steady_clock;
+
+enum class LogLevel : std::uint8_t{trace, debug, info, notice, warning, error, critical, fatal, _count};
+
+static_assert(enumName(Color::red) == "red" && enumName(LogLevel::warning) == "warning", "names");
+static_assert(enumName(static_cast<Color>(7)).empty(), "a value without an enumerator has no name");
+static_assert(*parseEnum<LogLevel>("fatal") == LogLevel::fatal && !parseEnum<LogLevel>("fatality"), "parse");
+static_assert(*parseEnum<Color>("black") == Color::black && !parseEnum<Color>("Black"), "parse is case sensitive");
+
+int main(){
+    cout << "Color     :";
+    for(auto name : enumNames<Color>()) cout << ' ' << name;
+    cout << endl << "LogLevel  :";
+    for(auto name : enumNames<LogLevel>()) cout << ' ' << name;
+    cout << endl << "perfect hash : " << enum_reflection<LogLevel>::slots << " slots, seed "
+         << enum_reflection<LogLevel>::hash.seed << endl;
+
+    /* what the log parser does today */
+    unordered_map<string, LogLevel> byName;
+    for(size_t i = 0; i < enum_size_v<LogLevel>; i++){
+        byName.emplace(string(enumNames<LogLevel>()[i]), static_cast<LogLevel>(i));
+    }
+
+    const size_t lines = 10000000;
+    vector<string> words{"debug", "info", "warning", "error", "trace", "notice", "critical", "fatal", "warn", "inf0"};
+    mt19937 gen(44);
+    uniform_int_distribution<size_t> pick(0, words.size() - 1);
+    vector<const string*> input(lines);
+    for(auto& w : input) w = &words[pick(gen)];
+
+    uint64_t mapSum = 0, hashSum = 0;
+    auto start = Clock::now();
+    for(auto w : input){
+        auto it = byName.find(*w);
+        mapSum += it == byName.end() ? 100 : toEmType(it->second);
+    }
+    double mapNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / lines;
+
+    start = Clock::now();
+    for(auto w : input){
+        auto level = parseEnum<LogLevel>(*w);
+        hashSum += level ? toEmType(*level) : 100;
+    }
+    double hashNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / lines;
+
+    cout << fixed << setprecision(1);
+    cout << lines << " level names parsed, ns per name" << endl;
+    cout << "  unordered_map<string, LogLevel> : " << setw(6) << mapNs << " (" << 1e3 / mapNs << " M/s)" << endl;
+    cout << "  parseEnum<LogLevel>             : " << setw(6) << hashNs << " (" << 1e3 / hashNs << " M/s)   "
+         << (mapSum == hashSum ? "same results" : "MISMATCH") << endl;
+    return mapSum == hashSum ? 0 : 1;
+}
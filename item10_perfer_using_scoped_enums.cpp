@@ -2,31 +2,14 @@
 #include <string>
 #include <cstdint>
 #include "type_name.hpp"
+#include "item10_to_em_type.h"
+#include "item10_color.h"
+#include "item10_enum_reflection.h"
+#include "item10_user_info.h"
 
 
 using namespace std;
 
-/* C++11 version */
-template<typename E>
-constexpr typename std::underlying_type<E>::type _toEmType(E enumerator){
-    return static_cast<typename std::underlying_type<E>::type>(enumerator);
-}
-
-
-/* C++14 version */
-template<typename E>
-constexpr std::underlying_type_t<E> toEmType(E emulator) noexcept{
-    return static_cast<std::underlying_type_t<E>>(emulator);
-}
-
-/* C++14 auto version */
-template<typename E>
-constexpr auto
-__toEmType(E enumerator){
-    return static_cast<std::underlying_type_t<E>>(enumerator);
-}
-
-
 int main(){
     // unscoped.
     // enum Color {black, white, red};
@@ -37,16 +20,18 @@ int main(){
     cout << "white in enum outer's scope : " << white;
     cout << "white in enum's scope : " << static_cast<int>(_Color::white) << endl;
     
-    // Declare underlying type for scoped enum.
-    enum class Color:std::uint8_t{
-        black, white, red
-    };
+    // Color (item10_color.h) declares its underlying type: std::uint8_t.
     cout << "Directly output the enumator :" << static_cast<int>(Color::white) << endl;
+    // Its name, found at compile time, and back again.
+    cout << "Enumerator's name : " << enumName(Color::white) << ", parsed back : "
+         << static_cast<int>(*parseEnum<Color>("white")) << endl;
 
-    using UserInfo = std::tuple<std::string, std::string, std::size_t>;
     UserInfo userInfo{"abc", "wz" ,1};
     auto first_v = std::get<1>(userInfo);
     cout << "first_v : " << first_v << endl;
+    // name the field instead of remembering that the email is field 1
+    auto email = std::get<toEmType(UserInfoFields::uiEmail)>(userInfo);
+    cout << "email : " << email << endl;
     auto _v = Color::black;
     // get underlying type of enum type.
     std::cout << "underlying type for enum Color : " << typeid(std::underlying_type<Color>::type).name() << endl;
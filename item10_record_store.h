@@ -0,0 +1,121 @@
+#pragma once
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "item10_to_em_type.h"
+
+/*
+    Records with a std::tuple schema stored column by column: field k of every record lives in its own
+    std::vector, and fields are named by a scoped enum through toEmType, as item10 does with std::get.
+
+        RecordStore<UserInfoFields, UserInfo> users;
+        users.append("abc", "abc@example.com", 1);
+        auto& reputations = users.column<UserInfoFields::uiReputation>();   // std::vector<std::size_t>&
+
+    A scan over some fields reads only those columns, so summing reputations streams 8-byte values and
+    never loads the two std::string columns, where a std::vector<UserInfo> would pull the whole 72-byte
+    record through the cache for each of them.
+*/
+template<typename E, typename Schema>
+class RecordStore;
+
+template<typename E, typename... Ts>
+class RecordStore<E, std::tuple<Ts...>>{
+public:
+    using record_type = std::tuple<Ts...>;
+    static constexpr std::size_t fieldCount = sizeof...(Ts);
+
+    template<E F>
+    using field_type = std::tuple_element_t<static_cast<std::size_t>(toEmType(F)), record_type>;
+
+    std::size_t size() const noexcept { return std::get<0>(columns).size(); }
+    bool empty() const noexcept { return size() == 0; }
+
+    void reserve(std::size_t n){
+        forEachColumn([n](auto& column){ column.reserve(n); });
+    }
+    void clear() noexcept{
+        forEachColumn([](auto& column){ column.clear(); });
+    }
+
+    /* One value per field. If a push_back throws, the columns that already grew are trimmed back. */
+    template<typename... Args, typename = std::enable_if_t<sizeof...(Args) == fieldCount>>
+    void append(Args&&... fields){
+        const std::size_t n = size();
+        try{
+            appendAt(std::index_sequence_for<Ts...>{}, std::forward<Args>(fields)...);
+        }catch(...){
+            forEachColumn([n](auto& column){ while(column.size() > n) column.pop_back(); });
+            throw;
+        }
+    }
+    void append(const record_type& record){
+        std::apply([this](const Ts&... fields){ append(fields...); }, record);
+    }
+    void append(record_type&& record){
+        std::apply([this](Ts&... fields){ append(std::move(fields)...); }, record);
+    }
+
+    /* Bulk append of records; reserves once when the range size is known up front. */
+    template<typename It, typename = std::enable_if_t<
+        std::is_convertible<typename std::iterator_traits<It>::value_type, record_type>::value>>
+    void append(It first, It last){
+        if constexpr(std::is_base_of<std::forward_iterator_tag,
+                                     typename std::iterator_traits<It>::iterator_category>::value){
+            reserve(size() + static_cast<std::size_t>(std::distance(first, last)));
+        }
+        for(; first != last; ++first) append(*first);
+    }
+
+    template<E F>
+    std::vector<field_type<F>>& column() noexcept{
+        return std::get<static_cast<std::size_t>(toEmType(F))>(columns);
+    }
+    template<E F>
+    const std::vector<field_type<F>>& column() const noexcept{
+        return std::get<static_cast<std::size_t>(toEmType(F))>(columns);
+    }
+
+    template<E F>
+    field_type<F>& get(std::size_t row) noexcept { return column<F>()[row]; }
+    template<E F>
+    const field_type<F>& get(std::size_t row) const noexcept { return column<F>()[row]; }
+
+    /* Reassembles one record; for reading a few fields use get or scan instead. */
+    record_type record(std::size_t row) const{
+        return recordAt(row, std::index_sequence_for<Ts...>{});
+    }
+
+    /* Projection scan: f(field values...) for every row, reading only the columns named in Fs. */
+    template<E... Fs, typename F>
+    void scan(F f) const{
+        static_assert(sizeof...(Fs) > 0, "scan needs at least one field");
+        auto cols = std::make_tuple(column<Fs>().data()...);
+        const std::size_t n = size();
+        for(std::size_t row = 0; row < n; row++){
+            std::apply([&f, row](const auto*... col){ f(col[row]...); }, cols);
+        }
+    }
+
+private:
+    template<std::size_t... I, typename... Args>
+    void appendAt(std::index_sequence<I...>, Args&&... fields){
+        (std::get<I>(columns).push_back(std::forward<Args>(fields)), ...);
+    }
+
+    template<std::size_t... I>
+    record_type recordAt(std::size_t row, std::index_sequence<I...>) const{
+        return record_type(std::get<I>(columns)[row]...);
+    }
+
+    template<typename F>
+    void forEachColumn(F f){
+        std::apply([&f](auto&... column){ (f(column), ...); }, columns);
+    }
+
+    std::tuple<std::vector<Ts>...> columns;
+};
@@ -0,0 +1,71 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "item10_record_store.h"
+#include "item10_user_info.h"
+
+using namespace std;
+
+/*
+    Summing one field of many UserInfo records: a std::vector<UserInfo> (one 72-byte tuple per row)
+    against a RecordStore, read through its column and through a projection scan.
+
+    The rows are made once and bulk-appended to the store. 100M rows need ~14 GB for the two copies;
+    the default is 5M, pass the row count to run more.
+
+    Usage : ./item10_record_store_benchmark [rows]
+*/
+
+using Clock = std::chrono::steady_clock;
+
+template<typename F>
+double msFor(F f){
+    double best = 1e300;
+    for(int rep = 0; rep < 3; rep++){
+        auto start = Clock::now();
+        f();
+        best = std::min(best, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+    return best;
+}
+
+int main(int argc, char* argv[]){
+    size_t rows = argc > 1 ? strtoull(argv[1], nullptr, 10) : 5000000;
+
+    vector<UserInfo> records;
+    records.reserve(rows);
+    for(size_t i = 0; i < rows; i++){
+        records.emplace_back("user" + to_string(i % 1000), "u" + to_string(i % 1000) + "@example.com", i % 977);
+    }
+
+    RecordStore<UserInfoFields, UserInfo> store;
+    auto start = Clock::now();
+    store.append(records.begin(), records.end());
+    double appendMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    size_t rowSum = 0, columnSum = 0, scanSum = 0;
+    double rowMs = msFor([&]{
+        rowSum = 0;
+        for(const auto& r : records) rowSum += std::get<toEmType(UserInfoFields::uiReputation)>(r);
+    });
+    double columnMs = msFor([&]{
+        columnSum = 0;
+        for(auto rep : store.column<UserInfoFields::uiReputation>()) columnSum += rep;
+    });
+    double scanMs = msFor([&]{
+        scanSum = 0;
+        store.scan<UserInfoFields::uiReputation>([&scanSum](size_t rep){ scanSum += rep; });
+    });
+
+    bool same = rowSum == columnSum && rowSum == scanSum && store.record(rows / 2) == records[rows / 2];
+    cout << fixed << setprecision(1);
+    cout << rows << " UserInfo rows, sizeof(UserInfo) " << sizeof(UserInfo) << " bytes, bulk append " << appendMs << " ms" << endl;
+    cout << "sum of reputations, best of 3" << endl;
+    cout << "  vector<UserInfo>         : " << setw(8) << rowMs << " ms, " << rows * sizeof(UserInfo) / 1e6 << " MB streamed" << endl;
+    cout << "  RecordStore column       : " << setw(8) << columnMs << " ms, " << rows * sizeof(size_t) / 1e6 << " MB streamed" << endl;
+    cout << "  RecordStore scan         : " << setw(8) << scanMs << " ms   " << (same ? "same sums" : "MISMATCH") << endl;
+    return same ? 0 : 1;
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <type_traits>
+
+/* C++11 version */
+template<typename E>
+constexpr typename std::underlying_type<E>::type _toEmType(E enumerator){
+    return static_cast<typename std::underlying_type<E>::type>(enumerator);
+}
+
+
+/* C++14 version */
+template<typename E>
+constexpr std::underlying_type_t<E> toEmType(E emulator) noexcept{
+    return static_cast<std::underlying_type_t<E>>(emulator);
+}
+
+/* C++14 auto version */
+template<typename E>
+constexpr auto
+__toEmType(E enumerator){
+    return static_cast<std::underlying_type_t<E>>(enumerator);
+}
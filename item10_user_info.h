@@ -0,0 +1,9 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <tuple>
+
+/* item10's user record: name, email, reputation. Its fields are addressed by UserInfoFields. */
+using UserInfo = std::tuple<std::string, std::string, std::size_t>;
+
+enum class UserInfoFields{uiName, uiEmail, uiReputation};
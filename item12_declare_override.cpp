@@ -1,24 +1,9 @@
 #include <iostream>
 #include <vector>
 #include <memory>
+#include "item12_widget.h"
 
 using namespace std;
-using dataType = vector<int>; 
-
-class Widget{
-public:
-    Widget(dataType& _data):data(_data){}
-    dataType& get() &{
-        cout << "return reference version" << endl;
-        return data;
-    }
-    dataType get() &&{
-        cout << "invoke move version" << endl;
-        return std::move(data);
-    }
-private:
-    dataType data;
-};
 
 class Base{
     public:
@@ -39,11 +24,6 @@ class Derived1: public Derived0{
         virtual void mf1() const && override { cout << "Rvalue Invoke Derived1's mf1() function" << endl;}
 };
 
-Widget makeWidget(){
-    dataType d{1,2};
-    Widget w(d);
-    return w;
-}
 int main(){
     dataType v{1,2,3};
     Widget w(v);
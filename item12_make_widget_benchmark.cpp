@@ -0,0 +1,76 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+#include "item12_widget.h"
+
+using namespace std;
+
+/*
+    Cost of item12's factory path, auto t = makeWidget().get(): build a data container, copy it into a
+    Widget, return the Widget and move the data out of the temporary with get() &&.
+
+    With std::vector<int> every call allocates twice (the local data and the Widget's copy of it). With
+    the small_vector<int, 4> that item12 now uses, the two ints stay inline and the path never reaches
+    the heap. small_vector<int, 1> is there as a control: its two ints spill, and the counter has to see
+    it. The global operator new below counts the allocations; cout is muted while timing because get()
+    prints on every call.
+
+    Usage : ./item12_make_widget_benchmark [calls]
+*/
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+size_t allocCount = 0;
+}
+
+void* operator new(size_t size){
+    ++allocCount;
+    if(void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept{
+    std::free(p);
+}
+
+template<typename Data>
+void measure(const string& name, long calls){
+    long sum = 0;
+    std::streambuf* out = cout.rdbuf(nullptr);
+    size_t allocsBefore = allocCount;
+    auto start = Clock::now();
+    for(long i = 0; i < calls; i++){
+        auto t = makeWidget<Data>().get();
+        sum += t[0] + t[1];
+    }
+    auto elapsed = Clock::now() - start;
+    size_t allocs = allocCount - allocsBefore;
+    cout.rdbuf(out);
+    cout.clear();
+
+    cout << left << setw(24) << name << right
+         << setw(12) << std::chrono::duration<double, std::nano>(elapsed).count() / calls
+         << setw(14) << double(allocs) / calls
+         << setw(10) << (sum == 3 * calls ? "ok" : "WRONG") << endl;
+}
+
+int main(int argc, char* argv[]){
+    long calls = argc > 1 ? atol(argv[1]) : 2000000;
+    cout << fixed << setprecision(1);
+    cout << "makeWidget().get(), " << calls << " calls" << endl;
+    cout << left << setw(24) << "data type" << right << setw(12) << "ns/call" << setw(14) << "allocs/call" << endl;
+    measure<vector<int>>("std::vector<int>", calls);
+    measure<dataType>("small_vector<int, 4>", calls);
+    /* two ints do not fit in one inline slot: the spill must show up as one allocation per copy */
+    measure<small_vector<int, 1>>("small_vector<int, 1>", calls);
+    return 0;
+}
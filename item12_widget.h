@@ -0,0 +1,36 @@
+#pragma once
+#include <iostream>
+#include <utility>
+#include "small_vector.hpp"
+
+/*
+    item12's Widget with reference-qualified get(): an lvalue Widget hands out a reference to its data, an
+    rvalue one moves the data out. It is a template over the data container only so that
+    item12_make_widget_benchmark can put the std::vector version next to the one item12 uses.
+*/
+template<typename Data>
+class BasicWidget{
+public:
+    BasicWidget(Data& _data):data(_data){}
+    Data& get() &{
+        std::cout << "return reference version" << std::endl;
+        return data;
+    }
+    Data get() &&{
+        std::cout << "invoke move version" << std::endl;
+        return std::move(data);
+    }
+private:
+    Data data;
+};
+
+/* A Widget holds a couple of ints: with small_vector neither makeWidget() nor get() touches the heap. */
+using dataType = small_vector<int, 4>;
+using Widget = BasicWidget<dataType>;
+
+template<typename Data = dataType>
+BasicWidget<Data> makeWidget(){
+    Data d{1,2};
+    BasicWidget<Data> w(d);
+    return w;
+}
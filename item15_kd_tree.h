@@ -0,0 +1,120 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <limits>
+#include "item15_point.h"
+
+/*
+    A 2-d tree over a fixed array of Points, built entirely by constexpr code. Declared as a constexpr
+    variable, the finished tree lands in .rodata next to item15's constexpr Points, so a process pays
+    nothing to build it at start-up and nearest() can be called at once, at run time or at compile time:
+
+        constexpr std::array<Point, 3> centroids{ Point(0, 0), Point(4, 1), Point(2, 5) };
+        constexpr StaticKdTree<3> regions(centroids);
+        std::size_t region = regions.nearest(Point(3, 2)).index;   // index into centroids
+
+    The tree is implicit: points are reordered so that every subrange [lo, hi) has its splitting point at
+    the middle, with smaller coordinates on the axis (x at even depths, y at odd) to its left. Equal
+    coordinates are ordered by input index, and nearest() prefers the lower index on equal distance, so
+    it always answers exactly what a linear scan over the input would.
+
+    Building takes O(N log N) on average. GCC counts constexpr evaluation steps; trees of several thousand
+    points may need -fconstexpr-ops-limit / -fconstexpr-loop-limit raised.
+*/
+template<std::size_t N>
+class StaticKdTree{
+    static_assert(N > 0, "StaticKdTree needs at least one point");
+
+public:
+    struct Nearest{
+        std::size_t index;      // position in the array the tree was built from
+        Point point;
+        double squaredDistance;
+    };
+
+    constexpr explicit StaticKdTree(const std::array<Point, N>& input){
+        for(std::size_t i = 0; i < N; i++){
+            points[i] = input[i];
+            ids[i] = i;
+        }
+        build(0, N, 0);
+    }
+
+    constexpr Nearest nearest(const Point& query) const noexcept{
+        Nearest best{N, Point(), std::numeric_limits<double>::infinity()};
+        search(0, N, 0, query, best);
+        return best;
+    }
+
+    constexpr std::size_t size() const noexcept { return N; }
+
+private:
+    static constexpr double coord(const Point& p, int axis) noexcept{
+        return axis == 0 ? p.xValue() : p.yValue();
+    }
+
+    /* strict order on one axis, ties broken by input index */
+    constexpr bool less(std::size_t a, std::size_t b, int axis) const noexcept{
+        double ca = coord(points[a], axis), cb = coord(points[b], axis);
+        return ca < cb || (ca == cb && ids[a] < ids[b]);
+    }
+
+    /* std::swap is not constexpr before C++20 */
+    constexpr void swapEntries(std::size_t a, std::size_t b) noexcept{
+        Point p = points[a];
+        points[a] = points[b];
+        points[b] = p;
+        std::size_t id = ids[a];
+        ids[a] = ids[b];
+        ids[b] = id;
+    }
+
+    /* quickselect: put the k-th smallest of [lo, hi) on this axis at k, smaller ones before it */
+    constexpr void select(std::size_t lo, std::size_t hi, std::size_t k, int axis) noexcept{
+        while(hi - lo > 1){
+            swapEntries(lo + (hi - lo) / 2, hi - 1);
+            std::size_t store = lo;
+            for(std::size_t i = lo; i < hi - 1; i++){
+                if(less(i, hi - 1, axis)) swapEntries(i, store++);
+            }
+            swapEntries(store, hi - 1);
+            if(k == store) return;
+            if(k < store) hi = store;
+            else lo = store + 1;
+        }
+    }
+
+    constexpr void build(std::size_t lo, std::size_t hi, int axis) noexcept{
+        if(hi - lo <= 1) return;
+        std::size_t mid = lo + (hi - lo) / 2;
+        select(lo, hi, mid, axis);
+        build(lo, mid, 1 - axis);
+        build(mid + 1, hi, 1 - axis);
+    }
+
+    constexpr void search(std::size_t lo, std::size_t hi, int axis, const Point& query, Nearest& best) const noexcept{
+        if(lo >= hi) return;
+        std::size_t mid = lo + (hi - lo) / 2;
+        double d = squaredDistance(query, points[mid]);
+        if(d < best.squaredDistance || (d == best.squaredDistance && ids[mid] < best.index)){
+            best = {ids[mid], points[mid], d};
+        }
+        double diff = coord(query, axis) - coord(points[mid], axis);
+        bool leftFirst = diff < 0;
+        if(leftFirst) search(lo, mid, 1 - axis, query, best);
+        else search(mid + 1, hi, 1 - axis, query, best);
+        /* the other side can only hold an equal or closer point if the splitting line is close enough */
+        if(diff * diff <= best.squaredDistance){
+            if(leftFirst) search(mid + 1, hi, 1 - axis, query, best);
+            else search(lo, mid, 1 - axis, query, best);
+        }
+    }
+
+    std::array<Point, N> points{};
+    std::array<std::size_t, N> ids{};
+};
+
+template<std::size_t N>
+constexpr StaticKdTree<N> makeKdTree(const std::array<Point, N>& input){
+    return StaticKdTree<N>(input);
+}
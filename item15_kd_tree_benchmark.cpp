@@ -0,0 +1,94 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "item15_kd_tree.h"
+#include "item15_lookup_table.h"
+
+using namespace std;
+
+/*
+    Nearest-centroid lookups against a fixed set of 512 region centroids.
+
+    The centroids and the tree over them are constexpr, so both sit in .rodata and the first query runs
+    without any set-up. For comparison we time building the same tree at run time (what start-up code
+    would do today) and answer 1M random queries with a linear scan and with the tree; all answers must agree.
+*/
+
+using Clock = std::chrono::steady_clock;
+
+/* splitmix64, so the "dataset" is a pure function of the index and can be generated by makeTable */
+constexpr std::uint64_t mix(std::uint64_t z) noexcept{
+    z += 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+constexpr std::size_t regionCount = 512;
+
+constexpr std::array<Point, regionCount> centroids = makeTable<Point, regionCount>([](std::size_t i){
+    /* a 1000 x 1000 km map, 0.001 km resolution */
+    return Point(double(mix(2 * i) % 1000000) / 1000, double(mix(2 * i + 1) % 1000000) / 1000);
+});
+
+constexpr StaticKdTree<regionCount> regions = makeKdTree(centroids);
+
+std::size_t linearNearest(const Point& q){
+    std::size_t best = 0;
+    double bestD = squaredDistance(q, centroids[0]);
+    for(std::size_t i = 1; i < regionCount; i++){
+        double d = squaredDistance(q, centroids[i]);
+        if(d < bestD){
+            bestD = d;
+            best = i;
+        }
+    }
+    return best;
+}
+
+/* answered by the compiler */
+constexpr std::size_t centreRegion = regions.nearest(Point(500, 500)).index;
+static_assert(regions.nearest(centroids[17]).index == 17, "a centroid is its own nearest region");
+
+int main(){
+    cout << fixed << setprecision(1);
+    cout << regionCount << " centroids, tree size " << sizeof(regions) << " bytes in .rodata" << endl;
+    cout << "region nearest (500, 500), computed at compile time : " << centreRegion
+         << " at (" << centroids[centreRegion].xValue() << ", " << centroids[centreRegion].yValue() << ")" << endl;
+
+    /* the start-up cost the constexpr tree avoids: the same constructor, on a runtime copy of the data */
+    auto input = centroids;
+    const int builds = 100;
+    auto start = Clock::now();
+    std::size_t sink = 0;
+    for(int i = 0; i < builds; i++){
+        input[0] = Point(input[0].xValue(), input[0].yValue() + i * 1e-9);
+        StaticKdTree<regionCount> runtimeTree(input);
+        sink += runtimeTree.nearest(Point(1, 1)).index;
+    }
+    double buildUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / builds;
+    cout << "building the tree at run time : " << buildUs << " us (constexpr tree: 0)" << endl;
+
+    const std::size_t queries = 1000000;
+    mt19937_64 gen(42);
+    uniform_real_distribution<double> coord(0, 1000);
+    vector<Point> qs(queries);
+    for(auto& q : qs) q = Point(coord(gen), coord(gen));
+
+    vector<std::size_t> linear(queries), tree(queries);
+    start = Clock::now();
+    for(std::size_t i = 0; i < queries; i++) linear[i] = linearNearest(qs[i]);
+    double linearNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / queries;
+    start = Clock::now();
+    for(std::size_t i = 0; i < queries; i++) tree[i] = regions.nearest(qs[i]).index;
+    double treeNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / queries;
+
+    bool same = linear == tree;
+    cout << queries << " nearest-region queries" << endl;
+    cout << "  linear scan : " << setw(8) << linearNs << " ns/query" << endl;
+    cout << "  k-d tree    : " << setw(8) << treeNs << " ns/query   " << (same ? "same answers" : "MISMATCH") << endl;
+    return same && sink != size_t(-1) ? 0 : 1;
+}
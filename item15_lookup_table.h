@@ -0,0 +1,68 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "item15_pow.h"
+
+/*
+    Compile-time lookup tables, item15 style: the generators are ordinary constexpr functions, and the
+    tables are constexpr variables, so the compiler evaluates them and emits the finished bytes into
+    .rodata. Nothing runs at startup and the tables cannot be written to.
+
+    makeTable<T, N>(f) builds { f(0), f(1), ..., f(N-1) }; f has to be usable in a constant expression
+    (a constexpr function or a lambda without captures). A generator that overflows or otherwise has
+    undefined behaviour is not a constant expression, so a table that does not fit its type fails to
+    compile instead of holding garbage.
+*/
+template<typename T, std::size_t N, typename F>
+constexpr std::array<T, N> makeTable(F f){
+    std::array<T, N> table{};
+    for(std::size_t i = 0; i < N; i++) table[i] = f(i);
+    return table;
+}
+
+/* Base^0 ... Base^(N-1) by item15's pow. */
+template<int Base, std::size_t N>
+constexpr std::array<int, N> makePowerTable(){
+    return makeTable<int, N>([](std::size_t e){ return pow(Base, static_cast<int>(e)); });
+}
+
+template<int Base, std::size_t N>
+inline constexpr std::array<int, N> powerTable = makePowerTable<Base, N>();
+
+/* One byte of the reflected CRC-32 (zlib, PNG, Ethernet: polynomial 0xEDB88320) computed bit by bit. */
+constexpr std::uint32_t crc32Entry(std::size_t byte) noexcept{
+    std::uint32_t crc = static_cast<std::uint32_t>(byte);
+    for(int bit = 0; bit < 8; bit++) crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+    return crc;
+}
+
+inline constexpr std::array<std::uint32_t, 256> crc32Table = makeTable<std::uint32_t, 256>(crc32Entry);
+
+/* Bitwise CRC-32, what the table replaces: eight shift/xor steps per byte. */
+constexpr std::uint32_t crc32Bitwise(const unsigned char* data, std::size_t size) noexcept{
+    std::uint32_t crc = 0xFFFFFFFFu;
+    for(std::size_t i = 0; i < size; i++){
+        crc ^= data[i];
+        for(int bit = 0; bit < 8; bit++) crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+    }
+    return ~crc;
+}
+
+/* Table-driven CRC-32: one lookup per byte. */
+constexpr std::uint32_t crc32(const unsigned char* data, std::size_t size) noexcept{
+    std::uint32_t crc = 0xFFFFFFFFu;
+    for(std::size_t i = 0; i < size; i++) crc = crc32Table[(crc ^ data[i]) & 0xFFu] ^ (crc >> 8);
+    return ~crc;
+}
+
+/* Set bits in every byte value. */
+inline constexpr std::array<std::uint8_t, 256> popcountTable = makeTable<std::uint8_t, 256>([](std::size_t b){
+    std::uint8_t bits = 0;
+    for(; b; b >>= 1) bits += b & 1u;
+    return bits;
+});
+
+static_assert(powerTable<3, 20>[19] == 1162261467, "3^19 is the largest power of 3 that fits an int");
+static_assert(crc32Table[1] == 0x77073096u && crc32Table[255] == 0x2D02EF8Du, "CRC-32 table mismatch");
+static_assert(popcountTable[0xFF] == 8 && popcountTable[0xA5] == 4, "popcount table mismatch");
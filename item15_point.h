@@ -0,0 +1,52 @@
+#pragma once
+
+// Constexpr functions are limited to taking and returning literal types, which essentially means types that can have 
+// values determined during compilation. Literal types can have user-defined types like class etc.
+
+class Point{
+public:
+    constexpr Point(double xVal = 0, double yVal = 0) noexcept :x(xVal), y(yVal){}; 
+    constexpr double xValue() const noexcept {return x;}
+    constexpr double yValue() const noexcept {return y;}
+    /* need C++14 or above version */
+    /* For C++11, we need the function (wants to be constexpr) should const itself, which means that 
+    constexpr ... setX(double newX) const nonexcept {x = newX} constradicts the const qualifier in the function
+    it will set the const object private member x.
+     Second, the return type is void.
+    */
+    constexpr void setX(double newX) noexcept {x = newX;}
+    constexpr void setY(double newY) noexcept {y = newY;}
+  
+private:
+    double x, y;
+};
+
+// Which means that the object mid, though its initialization involves calls to constructors, getters, and non-member function, can be
+// created in read-only memory. The more codes migrate from runtime to compile-time, the faster the code may run. (Compilation may take 
+// longer, however.)
+constexpr Point middlePoint(const Point& lhs, const Point& rhs) noexcept {
+   return {(lhs.xValue()+rhs.xValue())/2,(lhs.yValue() + rhs.yValue())/2};
+}
+
+/* refecltion function */
+constexpr Point reflection(const Point& p) noexcept{
+    Point result; // create non-const Point
+    result.setX(-p.xValue()); // set its x and y values.
+    result.setY(-p.yValue());
+    return result; // return copy of it.
+}
+
+/*
+    Correctly rounded IEEE adds, subtracts and multiplies only, so compile-time results and the AVX2
+    kernels in item15_point_batch.h agree bit for bit. (Built with FMA enabled, e.g. -march=haswell, GCC
+    may fuse dx * dx + dy * dy at run time; the kernels then differ in the last bit of squaredDistance.)
+*/
+constexpr Point translation(const Point& p, double dx, double dy) noexcept{
+    return {p.xValue() + dx, p.yValue() + dy};
+}
+
+constexpr double squaredDistance(const Point& lhs, const Point& rhs) noexcept{
+    double dx = lhs.xValue() - rhs.xValue();
+    double dy = lhs.yValue() - rhs.yValue();
+    return dx * dx + dy * dy;
+}
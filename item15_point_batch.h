@@ -0,0 +1,214 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+#include "item15_point.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <immintrin.h>
+    #define ITEM15_HAVE_AVX2_KERNELS 1
+#else
+    #define ITEM15_HAVE_AVX2_KERNELS 0
+#endif
+
+/*
+    Many Points in structure-of-arrays layout: all x values in one array, all y values in another, so a
+    kernel loads four x's or four y's with a single AVX2 instruction.
+
+    The batch operations below run item15's middlePoint, reflection, translation and squaredDistance on
+    every index. Each has a scalar loop that calls those constexpr functions and an AVX2 loop built with
+    __attribute__((target("avx2"))), so the rest of the program needs no special flags; the AVX2 one is
+    picked at run time when the CPU has it. Both use the same IEEE operations in the same order, so
+    they give the same bits as each other and as the constexpr functions evaluated at compile time.
+*/
+class PointBatch{
+public:
+    PointBatch() = default;
+    explicit PointBatch(std::size_t n):x(n), y(n){}
+
+    void reserve(std::size_t n){
+        x.reserve(n);
+        y.reserve(n);
+    }
+    void resize(std::size_t n){
+        x.resize(n);
+        y.resize(n);
+    }
+    void push_back(const Point& p){
+        x.push_back(p.xValue());
+        y.push_back(p.yValue());
+    }
+
+    std::size_t size() const noexcept { return x.size(); }
+    Point operator[](std::size_t i) const noexcept { return {x[i], y[i]}; }
+    void set(std::size_t i, const Point& p) noexcept{
+        x[i] = p.xValue();
+        y[i] = p.yValue();
+    }
+
+    double* xData() noexcept { return x.data(); }
+    const double* xData() const noexcept { return x.data(); }
+    double* yData() noexcept { return y.data(); }
+    const double* yData() const noexcept { return y.data(); }
+
+private:
+    std::vector<double> x, y;
+};
+
+namespace pointkernels{
+
+namespace scalar{
+
+inline void middlePoints(const double* ax, const double* ay, const double* bx, const double* by,
+                         double* ox, double* oy, std::size_t n) noexcept{
+    for(std::size_t i = 0; i < n; i++){
+        Point m = middlePoint(Point(ax[i], ay[i]), Point(bx[i], by[i]));
+        ox[i] = m.xValue();
+        oy[i] = m.yValue();
+    }
+}
+
+inline void reflections(const double* x, const double* y, double* ox, double* oy, std::size_t n) noexcept{
+    for(std::size_t i = 0; i < n; i++){
+        Point r = reflection(Point(x[i], y[i]));
+        ox[i] = r.xValue();
+        oy[i] = r.yValue();
+    }
+}
+
+inline void translations(double* x, double* y, double dx, double dy, std::size_t n) noexcept{
+    for(std::size_t i = 0; i < n; i++){
+        Point t = translation(Point(x[i], y[i]), dx, dy);
+        x[i] = t.xValue();
+        y[i] = t.yValue();
+    }
+}
+
+inline void distances(const double* ax, const double* ay, const double* bx, const double* by,
+                      double* out, std::size_t n) noexcept{
+    for(std::size_t i = 0; i < n; i++){
+        out[i] = std::sqrt(squaredDistance(Point(ax[i], ay[i]), Point(bx[i], by[i])));
+    }
+}
+
+} // namespace scalar
+
+#if ITEM15_HAVE_AVX2_KERNELS
+/* Four points per iteration; the tail of fewer than four goes through the scalar loop. */
+namespace avx2{
+
+__attribute__((target("avx2")))
+inline void middlePoints(const double* ax, const double* ay, const double* bx, const double* by,
+                         double* ox, double* oy, std::size_t n) noexcept{
+    const __m256d two = _mm256_set1_pd(2.0);
+    std::size_t i = 0;
+    for(; i + 4 <= n; i += 4){
+        __m256d mx = _mm256_div_pd(_mm256_add_pd(_mm256_loadu_pd(ax + i), _mm256_loadu_pd(bx + i)), two);
+        __m256d my = _mm256_div_pd(_mm256_add_pd(_mm256_loadu_pd(ay + i), _mm256_loadu_pd(by + i)), two);
+        _mm256_storeu_pd(ox + i, mx);
+        _mm256_storeu_pd(oy + i, my);
+    }
+    scalar::middlePoints(ax + i, ay + i, bx + i, by + i, ox + i, oy + i, n - i);
+}
+
+__attribute__((target("avx2")))
+inline void reflections(const double* x, const double* y, double* ox, double* oy, std::size_t n) noexcept{
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    std::size_t i = 0;
+    for(; i + 4 <= n; i += 4){
+        _mm256_storeu_pd(ox + i, _mm256_xor_pd(_mm256_loadu_pd(x + i), sign));
+        _mm256_storeu_pd(oy + i, _mm256_xor_pd(_mm256_loadu_pd(y + i), sign));
+    }
+    scalar::reflections(x + i, y + i, ox + i, oy + i, n - i);
+}
+
+__attribute__((target("avx2")))
+inline void translations(double* x, double* y, double dx, double dy, std::size_t n) noexcept{
+    const __m256d vdx = _mm256_set1_pd(dx), vdy = _mm256_set1_pd(dy);
+    std::size_t i = 0;
+    for(; i + 4 <= n; i += 4){
+        _mm256_storeu_pd(x + i, _mm256_add_pd(_mm256_loadu_pd(x + i), vdx));
+        _mm256_storeu_pd(y + i, _mm256_add_pd(_mm256_loadu_pd(y + i), vdy));
+    }
+    scalar::translations(x + i, y + i, dx, dy, n - i);
+}
+
+__attribute__((target("avx2")))
+inline void distances(const double* ax, const double* ay, const double* bx, const double* by,
+                      double* out, std::size_t n) noexcept{
+    std::size_t i = 0;
+    for(; i + 4 <= n; i += 4){
+        __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(ax + i), _mm256_loadu_pd(bx + i));
+        __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(ay + i), _mm256_loadu_pd(by + i));
+        __m256d sq = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+        _mm256_storeu_pd(out + i, _mm256_sqrt_pd(sq));
+    }
+    scalar::distances(ax + i, ay + i, bx + i, by + i, out + i, n - i);
+}
+
+} // namespace avx2
+#endif
+
+inline bool haveAvx2() noexcept{
+#if ITEM15_HAVE_AVX2_KERNELS
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+} // namespace pointkernels
+
+/*
+    Batch operations, dispatched to the AVX2 kernels when the CPU has AVX2. out may be the same batch as
+    an input; it is resized to the input size. Inputs of different sizes throw std::invalid_argument.
+*/
+inline void middlePoints(const PointBatch& lhs, const PointBatch& rhs, PointBatch& out){
+    if(lhs.size() != rhs.size()) throw std::invalid_argument("middlePoints: batches differ in size");
+    out.resize(lhs.size());
+#if ITEM15_HAVE_AVX2_KERNELS
+    if(pointkernels::haveAvx2()){
+        pointkernels::avx2::middlePoints(lhs.xData(), lhs.yData(), rhs.xData(), rhs.yData(),
+                                         out.xData(), out.yData(), lhs.size());
+        return;
+    }
+#endif
+    pointkernels::scalar::middlePoints(lhs.xData(), lhs.yData(), rhs.xData(), rhs.yData(),
+                                       out.xData(), out.yData(), lhs.size());
+}
+
+inline void reflections(const PointBatch& in, PointBatch& out){
+    out.resize(in.size());
+#if ITEM15_HAVE_AVX2_KERNELS
+    if(pointkernels::haveAvx2()){
+        pointkernels::avx2::reflections(in.xData(), in.yData(), out.xData(), out.yData(), in.size());
+        return;
+    }
+#endif
+    pointkernels::scalar::reflections(in.xData(), in.yData(), out.xData(), out.yData(), in.size());
+}
+
+inline void translations(PointBatch& batch, double dx, double dy){
+#if ITEM15_HAVE_AVX2_KERNELS
+    if(pointkernels::haveAvx2()){
+        pointkernels::avx2::translations(batch.xData(), batch.yData(), dx, dy, batch.size());
+        return;
+    }
+#endif
+    pointkernels::scalar::translations(batch.xData(), batch.yData(), dx, dy, batch.size());
+}
+
+/* out[i] = distance between lhs[i] and rhs[i]; out is resized to the batch size. */
+inline void distances(const PointBatch& lhs, const PointBatch& rhs, std::vector<double>& out){
+    if(lhs.size() != rhs.size()) throw std::invalid_argument("distances: batches differ in size");
+    out.resize(lhs.size());
+#if ITEM15_HAVE_AVX2_KERNELS
+    if(pointkernels::haveAvx2()){
+        pointkernels::avx2::distances(lhs.xData(), lhs.yData(), rhs.xData(), rhs.yData(), out.data(), lhs.size());
+        return;
+    }
+#endif
+    pointkernels::scalar::distances(lhs.xData(), lhs.yData(), rhs.xData(), rhs.yData(), out.data(), lhs.size());
+}
@@ -0,0 +1,116 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "item15_point_batch.h"
+
+using namespace std;
+
+/*
+    Scalar against AVX2 PointBatch kernels over a large point cloud, and a check that both give exactly
+    the bits the constexpr Point functions give at compile time.
+
+    Usage : ./item15_point_batch_benchmark [points]
+*/
+
+using Clock = std::chrono::steady_clock;
+
+template<typename F>
+double msFor(F f){
+    double best = 1e300;
+    for(int rep = 0; rep < 3; rep++){
+        auto start = Clock::now();
+        f();
+        best = std::min(best, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+    return best;
+}
+
+bool sameBits(const double* a, const double* b, size_t n){
+    return std::memcmp(a, b, n * sizeof(double)) == 0;
+}
+
+/* Computed by the compiler: the runtime kernels have to reproduce these bits. */
+constexpr Point ca(0.1, -2.5), cb(7.3, 1.0 / 3);
+constexpr Point cMid = middlePoint(ca, cb);
+constexpr Point cRef = reflection(ca);
+constexpr Point cMoved = translation(ca, 0.7, -0.3);
+constexpr double cSquared = squaredDistance(ca, cb);
+static_assert(cRef.xValue() == -0.1 && cRef.yValue() == 2.5, "reflection negates both coordinates");
+
+bool matchesCompileTime(){
+    PointBatch a, b, mid, ref;
+    for(int i = 0; i < 7; i++){ // 7: four through the vector loop, three through the tail
+        a.push_back(ca);
+        b.push_back(cb);
+    }
+    vector<double> dist;
+    middlePoints(a, b, mid);
+    reflections(a, ref);
+    distances(a, b, dist);
+    translations(a, 0.7, -0.3);
+    for(size_t i = 0; i < a.size(); i++){
+        if(mid[i].xValue() != cMid.xValue() || mid[i].yValue() != cMid.yValue()) return false;
+        if(ref[i].xValue() != cRef.xValue() || ref[i].yValue() != cRef.yValue()) return false;
+        if(a[i].xValue() != cMoved.xValue() || a[i].yValue() != cMoved.yValue()) return false;
+        if(dist[i] != std::sqrt(cSquared)) return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]){
+    size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 4000000;
+    mt19937_64 gen(41);
+    uniform_real_distribution<double> coord(-1e4, 1e4);
+    PointBatch a, b;
+    a.reserve(n);
+    b.reserve(n);
+    for(size_t i = 0; i < n; i++){
+        a.push_back(Point(coord(gen), coord(gen)));
+        b.push_back(Point(coord(gen), coord(gen)));
+    }
+
+    cout << "AVX2 " << (pointkernels::haveAvx2() ? "available" : "not available, the batch functions use the scalar loops") << endl;
+    cout << "compile-time and runtime results " << (matchesCompileTime() ? "agree" : "DIFFER") << endl;
+#if ITEM15_HAVE_AVX2_KERNELS
+    if(!pointkernels::haveAvx2()) return 0;
+
+    namespace sk = pointkernels::scalar;
+    namespace vk = pointkernels::avx2;
+    PointBatch s(n), v(n);
+    vector<double> sd(n), vd(n);
+    bool same = true;
+    auto row = [&](const char* name, double scalarMs, double avxMs, bool ok){
+        cout << left << setw(14) << name << right << fixed << setprecision(1)
+             << setw(12) << scalarMs << setw(12) << avxMs << setw(10) << scalarMs / avxMs << "x"
+             << "   " << (ok ? "same bits" : "MISMATCH") << endl;
+        same = same && ok;
+    };
+
+    cout << n << " points, best of 3, ms" << endl;
+    cout << left << setw(14) << "kernel" << right << setw(12) << "scalar" << setw(12) << "avx2" << setw(11) << "speedup" << endl;
+    double ms = msFor([&]{ sk::middlePoints(a.xData(), a.yData(), b.xData(), b.yData(), s.xData(), s.yData(), n); });
+    double mv = msFor([&]{ vk::middlePoints(a.xData(), a.yData(), b.xData(), b.yData(), v.xData(), v.yData(), n); });
+    row("midpoint", ms, mv, sameBits(s.xData(), v.xData(), n) && sameBits(s.yData(), v.yData(), n));
+
+    ms = msFor([&]{ sk::reflections(a.xData(), a.yData(), s.xData(), s.yData(), n); });
+    mv = msFor([&]{ vk::reflections(a.xData(), a.yData(), v.xData(), v.yData(), n); });
+    row("reflection", ms, mv, sameBits(s.xData(), v.xData(), n) && sameBits(s.yData(), v.yData(), n));
+
+    /* translate copies of a in place; three runs each, so both end up moved by the same amount */
+    s = a;
+    v = a;
+    ms = msFor([&]{ sk::translations(s.xData(), s.yData(), 0.25, -1.5, n); });
+    mv = msFor([&]{ vk::translations(v.xData(), v.yData(), 0.25, -1.5, n); });
+    row("translation", ms, mv, sameBits(s.xData(), v.xData(), n) && sameBits(s.yData(), v.yData(), n));
+
+    ms = msFor([&]{ sk::distances(a.xData(), a.yData(), b.xData(), b.yData(), sd.data(), n); });
+    mv = msFor([&]{ vk::distances(a.xData(), a.yData(), b.xData(), b.yData(), vd.data(), n); });
+    row("distance", ms, mv, sameBits(sd.data(), vd.data(), n));
+    return same ? 0 : 1;
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <limits>
+#include <optional>
+#include <type_traits>
+
+// In C++11, we can only have one return statement for a constexpr function.
+// So we need to write the function like pow(n, e) = n^e
+// only recursive version for pow.
+// constexpr int pow(int base, int exp) noexcept{
+//     return (exp == 0 ? 1: base * pow(base, exp-1));
+// }
+
+// C++14 standard, we can have more statements in constexpr function,
+// and we can write loop. This is the book's version: exp multiplications.
+
+template<typename T>
+constexpr T powLoop(T base, int exp) noexcept{
+    T result = 1;
+    for(int i = 0; i < exp; i++) result *= base;
+    return result;
+}
+
+/*
+    Exponentiation by squaring: O(log exp) multiplications, constexpr and usable at run time alike.
+    exp must be >= 0.
+
+    base is only squared while bits of exp remain, and each square ends up as a factor of the result, so
+    no intermediate overflows unless the result does. pow itself does not check: a signed result that
+    does not fit T is undefined behaviour at run time and a compile error in a constant expression. Use
+    checkedPow, saturatingPow or modPow when the result may not fit.
+*/
+template<typename T>
+constexpr T pow(T base, int exp) noexcept{
+    static_assert(std::is_integral<T>::value, "pow is for integers, use std::pow for floating point");
+    T result = 1;
+    while(exp > 0){
+        if(exp & 1) result *= base;
+        exp >>= 1;
+        if(exp) base *= base;
+    }
+    return result;
+}
+
+/* base^exp, or std::nullopt if it does not fit T. */
+template<typename T>
+constexpr std::optional<T> checkedPow(T base, int exp) noexcept{
+    static_assert(std::is_integral<T>::value, "checkedPow is for integers");
+    T result = 1;
+    while(exp > 0){
+        if((exp & 1) && __builtin_mul_overflow(result, base, &result)) return std::nullopt;
+        exp >>= 1;
+        if(exp && __builtin_mul_overflow(base, base, &base)) return std::nullopt;
+    }
+    return result;
+}
+
+/* base^exp, clamped to the largest or smallest T when it does not fit. */
+template<typename T>
+constexpr T saturatingPow(T base, int exp) noexcept{
+    if(auto result = checkedPow(base, exp)) return *result;
+    bool negative = base < 0 && (exp & 1);
+    return negative ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max();
+}
+
+/* base^exp mod m in [0, m) for m > 0. Products are taken in 128 bits, so any 64-bit m works. */
+template<typename T>
+constexpr T modPow(T base, unsigned long long exp, T m) noexcept{
+    static_assert(std::is_integral<T>::value && sizeof(T) <= 8, "modPow is for integers up to 64 bits");
+    using Wide = unsigned __int128;
+    Wide mod = static_cast<Wide>(m);
+    Wide b = base < 0 ? (mod - static_cast<Wide>(-(base + 1)) % mod - 1) : static_cast<Wide>(base) % mod;
+    Wide result = 1 % mod;
+    while(exp > 0){
+        if(exp & 1) result = result * b % mod;
+        exp >>= 1;
+        if(exp) b = b * b % mod;
+    }
+    return static_cast<T>(result);
+}
+
+static_assert(pow(3, 19) == 1162261467 && pow(-2, 31) == std::numeric_limits<int>::min(), "pow");
+static_assert(!checkedPow(3, 20) && *checkedPow(-2LL, 63) == std::numeric_limits<long long>::min(), "checkedPow");
+static_assert(saturatingPow(10, 12) == std::numeric_limits<int>::max() && saturatingPow(-10, 11) == std::numeric_limits<int>::min(), "saturatingPow");
+static_assert(modPow(2ULL, 64, 1000000007ULL) == 582344008ULL && modPow(-3, 3, 7) == 1, "modPow");
@@ -0,0 +1,71 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "item15_pow.h"
+
+using namespace std;
+
+/*
+    item15's loop pow against exponentiation by squaring and its checked, saturating and modular
+    variants, for exponents 1 .. 63. Every call in a row uses the same exponent with a different base,
+    the shape of a pricing loop that raises many rates to one period count.
+
+    powLoop and pow run on uint64_t so that overflow wraps instead of being undefined; the checked
+    and saturating variants run on int64_t, modPow on uint64_t modulo 1e9+7.
+*/
+
+using Clock = std::chrono::steady_clock;
+
+template<typename T>
+inline void doNotOptimize(T& value){
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+template<typename T, typename F>
+double nsPerCall(const vector<T>& bases, int exp, F f){
+    T sum = 0;
+    auto start = Clock::now();
+    for(T b : bases) sum += f(b, exp);
+    auto elapsed = Clock::now() - start;
+    doNotOptimize(sum);
+    return std::chrono::duration<double, std::nano>(elapsed).count() / bases.size();
+}
+
+int main(){
+    const size_t calls = 1000000;
+    mt19937_64 gen(40);
+    vector<uint64_t> ubases(calls);
+    vector<int64_t> sbases(calls);
+    for(size_t i = 0; i < calls; i++){
+        ubases[i] = gen() % 16;
+        sbases[i] = static_cast<int64_t>(gen() % 7) - 3;
+    }
+    const uint64_t mod = 1000000007ULL;
+
+    cout << fixed << setprecision(1);
+    cout << "ns per call, " << calls << " calls per exponent" << endl;
+    cout << setw(5) << "exp" << setw(10) << "loop" << setw(10) << "squaring"
+         << setw(10) << "checked" << setw(12) << "saturating" << setw(10) << "modular" << endl;
+    for(int exp : {1, 2, 4, 7, 8, 15, 16, 31, 32, 47, 63}){
+        cout << setw(5) << exp
+             << setw(10) << nsPerCall(ubases, exp, [](uint64_t b, int e){ return powLoop(b, e); })
+             << setw(10) << nsPerCall(ubases, exp, [](uint64_t b, int e){ return pow(b, e); })
+             << setw(10) << nsPerCall(sbases, exp, [](int64_t b, int e){ return checkedPow(b, e).value_or(0); })
+             << setw(12) << nsPerCall(sbases, exp, [](int64_t b, int e){ return saturatingPow(b, e); })
+             << setw(10) << nsPerCall(ubases, exp, [mod](uint64_t b, int e){ return modPow(b, e, mod); }) << endl;
+    }
+
+    /* the squaring and loop results must agree wherever the loop is exact */
+    for(int exp = 0; exp <= 63; exp++){
+        for(uint64_t b = 0; b < 16; b++){
+            if(pow(b, exp) != powLoop(b, exp)){
+                cout << "MISMATCH " << b << "^" << exp << endl;
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
@@ -3,6 +3,7 @@
 #include <mutex>
 #include <atomic>
 #include "type_name.hpp"
+#include "small_vector.hpp"
 
 using namespace std;
 
@@ -13,13 +14,15 @@ using namespace std;
 */
 class Polynomial{
 public:
-    using RootsType = std::vector<double>;
+    /* A polynomial of low degree has only a few roots: keep them inline instead of on the heap. */
+    using RootsType = small_vector<double, 4>;
     /* Two threads writeing and reading data in Polynomial object will be unpredictable. */
     RootsType roots() const{
         if(!rootsAreValid){
             //...
             rootsAreValid = true;
         }
+        return rootVals;
     }
 private:
     //Add mutable qualifier, so we can modify these members in const roots member function.
@@ -30,7 +33,7 @@ private:
 /* Add mutex to synchronize threads */
 class PolynomialMutex{
 public:
-    using RootsType = std::vector<double>;
+    using RootsType = small_vector<double, 4>;
     RootsType roots() const{
         std::lock_guard<std::mutex> g(m);
         if(!rootsAreValid){
@@ -38,6 +41,7 @@ public:
             // ...
             rootsAreValid = true;
         }
+        return rootVals;
     }
 
 private:
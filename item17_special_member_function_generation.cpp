@@ -1,6 +1,9 @@
 #include <iostream>
 #include "type_name.hpp"
 #include <map>
+#include <chrono>
+#include <vector>
+#include "item17_string_table.h"
 
 using namespace std;
 
@@ -54,40 +57,7 @@ void f(Base& t){
     we have declared 
 */
 
-class StringTable{
-public:
-    using dataType = map<int, string>;
-    StringTable(){
-        cout << "Creating StringTable object \n";
-    }
-     ~StringTable(){
-        cout << "Using StringTable destructor \n";
-    }
-    /* move operation */
-    // StringTable& operator = (StringTable&& st){
-    //     values = std::move(st.values);
-    //     return *this;
-    // }
-
-    StringTable(StringTable&&) = default;
-    StringTable& operator = (StringTable&&) = default; // Support moving 
-
-    // StringTable(const StringTable&) = default; // Support copying
-    // StringTable& operator= (StringTable&) = default;
-    // StringTable& operator = (StringTable &st){
-    //     values = st.values;
-    //     return *this;
-    // }
-   // StringTable& operator = ()
-    void setValue(pair<int, string>&& p){
-        values.insert(p);
-    }
-    unsigned int size(){
-        return values.size();
-    }
-private:
-    dataType values; 
-};
+/* StringTable lives in item17_string_table.h, so item_move_guard can check its move operations too. */
 
 
 /** Three things to decide move action to be generated or not */
@@ -114,11 +84,40 @@ int main(){
     //Derived* d0 = &d1;
     //delete(d0);
     //f(d0);
+    using std::chrono::duration_cast;
+    using std::chrono::milliseconds;
+    /* The same 10M inserts into the flat, arena-backed table. Keys arrive in order, so every insert is an append.
+       Run in their own scope before the map, so neither benchmark pays for the other's memory. */
+    {
+        auto start = std::chrono::steady_clock::now();
+        ArenaStringTable ast;
+        for(int i = 0; i < 10000000; i++){
+            ast.setValue(make_pair(i, "abc"));
+        }
+        cout << "ArenaStringTable 10M setValue : " << duration_cast<milliseconds>(std::chrono::steady_clock::now() - start).count() << " ms" << endl;
+        /* every value is "abc", so the pool holds it once and each entry stores only its 32-bit id */
+        cout << "ArenaStringTable distinct values : " << ast.stringPool()->size() << endl;
+    }
+    {
+        /* Bulk path: one pre-sized copy of an already sorted batch. */
+        vector<pair<int, string>> batch;
+        batch.reserve(10000000);
+        for(int i = 0; i < 10000000; i++){
+            batch.emplace_back(i, "abc");
+        }
+        auto start = std::chrono::steady_clock::now();
+        ArenaStringTable ast;
+        ast.insert_sorted(batch.begin(), batch.end());
+        cout << "ArenaStringTable 10M insert_sorted : " << duration_cast<milliseconds>(std::chrono::steady_clock::now() - start).count() << " ms" << endl;
+    }
+    auto start = std::chrono::steady_clock::now();
     StringTable st;
     for(int i = 0; i < 10000000; i++){
         st.setValue(make_pair(i, "abc"));
     }
     cout << "st' values size : " << st.size() << endl;
+    cout << "StringTable (map) 10M setValue : " << duration_cast<milliseconds>(std::chrono::steady_clock::now() - start).count() << " ms" << endl;
+
     StringTable st1;
 
     /*
@@ -0,0 +1,133 @@
+#include <iostream>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <string_view>
+#include <vector>
+#include "item17_string_table.h"
+
+using namespace std;
+
+/*
+    Checks for the storage behind ArenaStringTable. Every view the arena hands out must keep its bytes,
+    including around strings longer than a chunk, which get a chunk of their own. StringPool must hand
+    equal strings equal ids, from one thread or many, and lookup(id) must give the string back.
+
+    Exits with 1 and names the failing check if anything is wrong.
+*/
+
+bool check(bool good, const char* what){
+    cout << (good ? "  ok     " : "  FAILED ") << what << endl;
+    return good;
+}
+
+bool arenaKeepsEveryView(){
+    StringArena arena;
+    vector<string> originals;
+    vector<string_view> views;
+    auto store = [&](string s){
+        originals.push_back(std::move(s));
+        views.push_back(arena.store(originals.back()));
+    };
+    store("abc");
+    store(string(StringArena::chunkSize + 4464, 'B'));
+    store("xyz");
+    /* enough small strings to spill into further chunks, with another oversized one in between */
+    for(int i = 0; i < 20000; i++){
+        store("value-" + to_string(i));
+        if(i == 10000) store(string(3 * StringArena::chunkSize, 'C'));
+    }
+    /* views survive a move, and the new owner keeps bumping after them */
+    StringArena moved(std::move(arena));
+    originals.push_back("after move");
+    views.push_back(moved.store(originals.back()));
+
+    bool good = true;
+    for(size_t i = 0; i < views.size(); i++) good = good && views[i] == originals[i];
+    return good;
+}
+
+/* the pool's map keys point into the arena: an oversized string must not disturb them */
+bool poolDeduplicatesAroundOversized(){
+    StringPool pool;
+    string big(StringArena::chunkSize + 4464, 'B');
+    auto abc = pool.intern("abc");
+    auto b = pool.intern(big);
+    auto xyz = pool.intern("xyz");
+    return pool.intern(big) == b && pool.intern("abc") == abc && pool.intern("xyz") == xyz
+        && pool.lookup(b) == big && pool.lookup(abc) == "abc" && pool.lookup(xyz) == "xyz" && pool.size() == 3;
+}
+
+/*
+    Threads intern overlapping ranges of strings (thread t takes strings t * 500 to t * 500 + 2000, so
+    each string is interned by up to four threads, some of them oversized) while reading back what they
+    got through the lock-free lookup.
+*/
+bool poolIsConsistentAcrossThreads(unsigned threads){
+    const int perThread = 2000, stride = 500;
+    auto text = [](int i){
+        return i % 997 == 0 ? string(StringArena::chunkSize + size_t(i), char('a' + i % 26)) : "string-" + to_string(i);
+    };
+    StringPool pool;
+    vector<vector<StringPool::id_type>> got(threads, vector<StringPool::id_type>(perThread));
+    atomic<bool> lookupsGood{true};
+    vector<std::thread> workers;
+    for(unsigned t = 0; t < threads; t++){
+        workers.emplace_back([&, t]{
+            for(int j = 0; j < perThread; j++){
+                int i = int(t) * stride + j;
+                string s = text(i);
+                auto id = pool.intern(s);
+                got[t][size_t(j)] = id;
+                if(pool.lookup(id) != s) lookupsGood = false;
+            }
+        });
+    }
+    for(auto& w : workers) w.join();
+
+    bool good = lookupsGood;
+    int distinct = int(threads - 1) * stride + perThread;
+    vector<long> idOf(size_t(distinct), -1);
+    for(unsigned t = 0; t < threads; t++){
+        for(int j = 0; j < perThread; j++){
+            int i = int(t) * stride + j;
+            if(idOf[size_t(i)] < 0) idOf[size_t(i)] = got[t][size_t(j)];
+            good = good && idOf[size_t(i)] == long(got[t][size_t(j)]);
+        }
+    }
+    for(int i = 0; i < distinct; i++) good = good && pool.lookup(StringPool::id_type(idOf[size_t(i)])) == text(i);
+    return good && pool.size() == size_t(distinct);
+}
+
+/* a sorted run merged into existing keys lands in order, and existing keys keep their values */
+bool mergeKeepsOrder(){
+    ArenaStringTable table;
+    for(int k = 0; k < 1000; k += 2) table.insert(k, "even");
+    vector<pair<int, string>> run;
+    for(int k = 1; k < 2000; k += 3) run.emplace_back(k, "run");
+    table.insert_sorted(run.begin(), run.end());
+
+    size_t expectedSize = 0;
+    bool good = true;
+    for(int k = 0; k < 2000; k++){
+        auto v = table.find(k);
+        bool even = k < 1000 && k % 2 == 0, inRun = k % 3 == 1;
+        if(even) good = good && v && *v == "even";
+        else if(inRun) good = good && v && *v == "run";
+        else good = good && !v;
+        expectedSize += even || inRun;
+    }
+    return good && table.size() == expectedSize;
+}
+
+int main(){
+    bool ok = true;
+    cout << "StringArena" << endl;
+    ok = check(arenaKeepsEveryView(), "small, oversized and small again: every view unchanged") && ok;
+    cout << "StringPool" << endl;
+    ok = check(poolDeduplicatesAroundOversized(), "re-interning around an oversized string gives the same ids") && ok;
+    ok = check(poolIsConsistentAcrossThreads(8), "8 threads, overlapping strings: equal strings equal ids, lookup round-trips") && ok;
+    cout << "ArenaStringTable" << endl;
+    ok = check(mergeKeepsOrder(), "insert_sorted merge: every key once, existing values kept") && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,317 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/*
+    The item17 StringTable: declaring ~StringTable() suppresses the implicit move operations, so they are
+    defaulted explicitly - without them st1 = std::move(st) silently becomes a copy of every entry.
+*/
+class StringTable{
+public:
+    using dataType = std::map<int, std::string>;
+    StringTable(){
+        std::cout << "Creating StringTable object \n";
+    }
+     ~StringTable(){
+        std::cout << "Using StringTable destructor \n";
+    }
+    /* move operation */
+    // StringTable& operator = (StringTable&& st){
+    //     values = std::move(st.values);
+    //     return *this;
+    // }
+
+    StringTable(StringTable&&) = default;
+    StringTable& operator = (StringTable&&) = default; // Support moving 
+
+    // StringTable(const StringTable&) = default; // Support copying
+    // StringTable& operator= (StringTable&) = default;
+    // StringTable& operator = (StringTable &st){
+    //     values = st.values;
+    //     return *this;
+    // }
+   // StringTable& operator = ()
+    void setValue(std::pair<int, std::string>&& p){
+        values.insert(p);
+    }
+    unsigned int size(){
+        return values.size();
+    }
+private:
+    dataType values; 
+};
+
+/*
+    Bump allocator for string bytes. Strings are copied into large chunks and handed back as string_views
+    that stay valid until the arena is destroyed; moving the arena moves only the chunk pointers, so the
+    views survive a move as well. A string longer than a chunk gets a chunk of its own, and bumping carries
+    on in the current chunk.
+*/
+class StringArena{
+public:
+    static constexpr std::size_t chunkSize = 64 * 1024;
+
+    StringArena() = default;
+    StringArena(StringArena&& other) noexcept
+        :chunks(std::move(other.chunks)), cur(std::exchange(other.cur, nullptr)), used(std::exchange(other.used, 0)){}
+    StringArena& operator=(StringArena&& other) noexcept{
+        chunks = std::move(other.chunks);
+        cur = std::exchange(other.cur, nullptr);
+        used = std::exchange(other.used, 0);
+        return *this;
+    }
+
+    std::string_view store(std::string_view s){
+        if(s.empty()) return {};
+        if(s.size() > chunkSize){
+            chunks.push_back(std::make_unique<char[]>(s.size()));
+            std::memcpy(chunks.back().get(), s.data(), s.size());
+            return {chunks.back().get(), s.size()};
+        }
+        if(!cur || used + s.size() > chunkSize){
+            chunks.push_back(std::make_unique<char[]>(chunkSize));
+            cur = chunks.back().get();
+            used = 0;
+        }
+        char* p = cur + used;
+        std::memcpy(p, s.data(), s.size());
+        used += s.size();
+        return {p, s.size()};
+    }
+
+    void clear() noexcept{
+        chunks.clear();
+        cur = nullptr;
+        used = 0;
+    }
+
+private:
+    std::vector<std::unique_ptr<char[]>> chunks;
+    char* cur = nullptr; // the chunk being bumped into, never an oversized one
+    std::size_t used = 0;
+};
+
+/*
+    Interning pool: every distinct string is stored once, immutable, and named by a 32-bit id.
+
+    intern() may be called from any number of threads; lookups by content take a shared lock and only a
+    new string takes the exclusive one. lookup(id) takes no lock at all: ids index a segmented array whose
+    segments never move once published, so a thread that was handed an id can always read its string.
+*/
+class StringPool{
+public:
+    using id_type = std::uint32_t;
+
+    StringPool() = default;
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+    ~StringPool(){
+        for(auto& segment : segments) delete[] segment.load(std::memory_order_relaxed);
+    }
+
+    id_type intern(std::string_view s){
+        {
+            std::shared_lock<std::shared_mutex> lock(m);
+            auto it = ids.find(s);
+            if(it != ids.end()) return it->second;
+        }
+        std::unique_lock<std::shared_mutex> lock(m);
+        auto it = ids.find(s);
+        if(it != ids.end()) return it->second;
+
+        std::size_t id = count.load(std::memory_order_relaxed);
+        if(id >= maxStrings) throw std::length_error("StringPool: id space exhausted");
+        std::string_view stored = arena.store(s);
+        auto seg = segmentOf(id);
+        std::string_view* segment = segments[seg].load(std::memory_order_relaxed);
+        if(!segment){
+            segment = new std::string_view[firstSegment << seg];
+            segments[seg].store(segment, std::memory_order_release);
+        }
+        segment[id - segmentStart(seg)] = stored;
+        ids.emplace(stored, static_cast<id_type>(id));
+        count.store(id + 1, std::memory_order_release);
+        return static_cast<id_type>(id);
+    }
+
+    /* id must come from intern() on this pool. */
+    std::string_view lookup(id_type id) const noexcept{
+        auto seg = segmentOf(id);
+        return segments[seg].load(std::memory_order_acquire)[id - segmentStart(seg)];
+    }
+
+    std::size_t size() const noexcept{
+        return count.load(std::memory_order_acquire);
+    }
+
+private:
+    /* Segment k holds firstSegment << k ids, so 26 segments cover the whole 32-bit id space. */
+    static constexpr std::size_t firstSegmentBits = 6;
+    static constexpr std::size_t firstSegment = std::size_t{1} << firstSegmentBits;
+    static constexpr std::size_t segmentCount = 32 - firstSegmentBits;
+    static constexpr std::size_t maxStrings = (firstSegment << segmentCount) - firstSegment;
+
+    static std::size_t segmentOf(std::size_t id) noexcept{
+        std::size_t v = (id + firstSegment) >> firstSegmentBits, seg = 0;
+        while(v >>= 1) ++seg;
+        return seg;
+    }
+    static std::size_t segmentStart(std::size_t seg) noexcept{
+        return (firstSegment << seg) - firstSegment;
+    }
+
+    mutable std::shared_mutex m;
+    StringArena arena;
+    std::unordered_map<std::string_view, id_type> ids;
+    std::atomic<std::string_view*> segments[segmentCount] = {};
+    std::atomic<std::size_t> count{0};
+};
+
+/*
+    StringTable (item17) keeps a std::map<int, string>: one tree node and one std::string per entry.
+    ArenaStringTable keeps the keys in a sorted flat vector and the values as ids into a StringPool, so an
+    entry costs two 32-bit words however long its value is, equal values are stored once, lookups are a
+    binary search over contiguous keys, and appending in key order is a push_back. Moving a table is O(1)
+    and noexcept. Copies, and tables constructed from the same pool, share the interned strings.
+
+    Like map::insert, inserting a key that is already present keeps the old value.
+*/
+class ArenaStringTable{
+public:
+    using key_type = int;
+    using id_type = StringPool::id_type;
+
+    ArenaStringTable() = default; // the pool is created by the first insert
+    explicit ArenaStringTable(std::shared_ptr<StringPool> sharedPool):pool(std::move(sharedPool)){}
+    ArenaStringTable(const ArenaStringTable&) = default;
+    ArenaStringTable& operator=(const ArenaStringTable&) = default;
+    ArenaStringTable(ArenaStringTable&&) noexcept = default;
+    ArenaStringTable& operator=(ArenaStringTable&&) noexcept = default;
+
+    void reserve(std::size_t n){
+        keys.reserve(n);
+        values.reserve(n);
+    }
+
+    bool setValue(std::pair<key_type, std::string>&& p){
+        return insert(p.first, p.second);
+    }
+
+    bool insert(key_type key, std::string_view value){
+        if(keys.empty() || key > keys.back()){
+            keys.push_back(key);
+            values.push_back(intern(value));
+            return true;
+        }
+        auto it = std::lower_bound(keys.begin(), keys.end(), key);
+        if(*it == key) return false;
+        auto pos = it - keys.begin();
+        keys.insert(it, key);
+        values.insert(values.begin() + pos, intern(value));
+        return true;
+    }
+
+    /*
+        Bulk insert of (key, value) pairs already sorted by key. Appending past the current largest key is
+        a straight copy; otherwise the run is merged with the existing entries in one O(n + m) pass.
+     */
+    template<typename It>
+    void insert_sorted(It first, It last){
+        if(first == last) return;
+        if(keys.empty() || first->first > keys.back()){
+            if constexpr(std::is_base_of<std::random_access_iterator_tag,
+                               typename std::iterator_traits<It>::iterator_category>::value){
+                reserve(keys.size() + static_cast<std::size_t>(std::distance(first, last)));
+            }
+            for(; first != last; ++first){
+                if(!keys.empty() && first->first == keys.back()) continue;
+                keys.push_back(first->first);
+                values.push_back(intern(first->second));
+            }
+            return;
+        }
+
+        std::size_t capacity = keys.size();
+        if constexpr(std::is_base_of<std::random_access_iterator_tag,
+                           typename std::iterator_traits<It>::iterator_category>::value){
+            capacity += static_cast<std::size_t>(std::distance(first, last));
+        }
+        std::vector<key_type> mergedKeys;
+        std::vector<id_type> mergedValues;
+        mergedKeys.reserve(capacity);
+        mergedValues.reserve(capacity);
+        std::size_t i = 0;
+        auto push = [&](key_type key, id_type value){
+            mergedKeys.push_back(key);
+            mergedValues.push_back(value);
+        };
+        for(; first != last; ++first){
+            while(i < keys.size() && keys[i] <= first->first){
+                push(keys[i], values[i]);
+                ++i;
+            }
+            if(mergedKeys.empty() || first->first != mergedKeys.back()){
+                push(first->first, intern(first->second));
+            }
+        }
+        for(; i < keys.size(); ++i) push(keys[i], values[i]);
+        keys.swap(mergedKeys);
+        values.swap(mergedValues);
+    }
+
+    std::optional<std::string_view> find(key_type key) const{
+        auto it = std::lower_bound(keys.begin(), keys.end(), key);
+        if(it == keys.end() || *it != key) return std::nullopt;
+        return pool->lookup(values[it - keys.begin()]);
+    }
+
+    std::size_t size() const noexcept{
+        return keys.size();
+    }
+
+    /* null until something has been inserted, unless the table was built on a shared pool */
+    const std::shared_ptr<StringPool>& stringPool() const noexcept{
+        return pool;
+    }
+
+    void clear() noexcept{
+        keys.clear();
+        values.clear();
+    }
+
+private:
+    /* Low-cardinality columns repeat the same value back to back; skip the pool for a repeat. */
+    id_type intern(std::string_view value){
+        if(!pool){ // first insert, or a moved-from table
+            pool = std::make_shared<StringPool>();
+            hasLast = false;
+        }
+        if(hasLast && pool->lookup(lastId) == value) return lastId;
+        lastId = pool->intern(value);
+        hasLast = true;
+        return lastId;
+    }
+
+    std::vector<key_type> keys;
+    std::vector<id_type> values;
+    std::shared_ptr<StringPool> pool;
+    id_type lastId = 0;
+    bool hasLast = false;
+};
@@ -0,0 +1,138 @@
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <functional>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <new>
+#include <cstddef>
+#include <type_traits>
+
+using namespace std;
+
+/*
+    Memory footprint of the smart pointer layouts used in item18 - item22.
+
+    Every configuration below creates N handles to a small Widget and keeps them alive in a vector, while
+    the global operator new/delete count what is requested from the heap. For each one we report
+        handle     : sizeof the pointer object itself (what sits in your container)
+        ctrl block : heap bytes per object that are not the Widget (the control block, or the whole
+                     make_shared block once only weak_ptrs keep it alive)
+        allocs     : heap allocations per object
+        heap       : live heap bytes per object
+        total      : handle + heap, per object and for all N objects
+    Bytes are the sizes requested from operator new; malloc's own chunk header and rounding come on top.
+
+    Usage : ./item21_smart_pointer_footprint [objectCount]
+*/
+
+namespace {
+size_t allocCount = 0;
+size_t liveBytes = 0;
+/* Every block carries its size in front of it, so operator delete can keep liveBytes exact. */
+constexpr size_t headerSize = alignof(std::max_align_t);
+}
+
+void* operator new(size_t size){
+    void* p = std::malloc(size + headerSize);
+    if(!p) throw std::bad_alloc();
+    *static_cast<size_t*>(p) = size;
+    ++allocCount;
+    liveBytes += size;
+    return static_cast<char*>(p) + headerSize;
+}
+
+void operator delete(void* p) noexcept{
+    if(!p) return;
+    void* block = static_cast<char*>(p) - headerSize;
+    liveBytes -= *static_cast<size_t*>(block);
+    std::free(block);
+}
+
+void operator delete(void* p, size_t) noexcept{
+    operator delete(p);
+}
+
+class Widget{
+public:
+    Widget(int _v = 0):v(_v){}
+    int getValue() const {return v;}
+private:
+    int v;
+};
+
+auto widgetDeleter = [](Widget* pw){ delete pw; };
+
+/*
+    makeHandle(i) returns the handle we keep per object. payloadAlive tells whether the Widget itself is
+    still counted in the live heap bytes (it is not once only a weak_ptr is left).
+ */
+template<typename MakeHandle>
+void report(const string& name, size_t n, bool payloadAlive, MakeHandle makeHandle){
+    using Handle = decltype(makeHandle(size_t{0}));
+    vector<Handle> handles;
+    handles.reserve(n);
+
+    size_t allocs0 = allocCount, bytes0 = liveBytes;
+    for(size_t i = 0; i < n; ++i){
+        handles.push_back(makeHandle(i));
+    }
+    double allocs = double(allocCount - allocs0) / n;
+    double heap = double(liveBytes - bytes0) / n;
+    double ctrl = payloadAlive ? heap - sizeof(Widget) : heap;
+    double total = sizeof(Handle) + heap;
+
+    cout << left << setw(34) << name << right
+         << setw(8) << sizeof(Handle)
+         << setw(12) << fixed << setprecision(1) << ctrl
+         << setw(9) << setprecision(2) << allocs
+         << setw(9) << setprecision(1) << heap
+         << setw(10) << total
+         << setw(14) << setprecision(2) << total * n / (1024.0 * 1024.0) << endl;
+
+    if constexpr (std::is_pointer<Handle>::value){
+        for(auto p : handles) delete p;
+    }
+}
+
+int main(int argc, char* argv[]){
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    if(n == 0) n = 1;
+
+    cout << "Objects : " << n << ", sizeof(Widget) : " << sizeof(Widget) << endl;
+    cout << left << setw(34) << "configuration" << right
+         << setw(8) << "handle" << setw(12) << "ctrl block" << setw(9) << "allocs"
+         << setw(9) << "heap" << setw(10) << "total" << setw(14) << "total MiB" << endl;
+
+    report("Widget* (raw new)", n, true, [](size_t i){
+        return new Widget(int(i));
+    });
+    report("unique_ptr<Widget>", n, true, [](size_t i){
+        return std::make_unique<Widget>(int(i));
+    });
+    report("unique_ptr<Widget, lambda>", n, true, [](size_t i){
+        return std::unique_ptr<Widget, decltype(widgetDeleter)>(new Widget(int(i)), widgetDeleter);
+    });
+    report("unique_ptr<Widget, function<>>", n, true, [](size_t i){
+        return std::unique_ptr<Widget, std::function<void(Widget*)>>(new Widget(int(i)), widgetDeleter);
+    });
+    report("shared_ptr<Widget>(new)", n, true, [](size_t i){
+        return std::shared_ptr<Widget>(new Widget(int(i)));
+    });
+    report("shared_ptr<Widget>(new, lambda)", n, true, [](size_t i){
+        return std::shared_ptr<Widget>(new Widget(int(i)), widgetDeleter);
+    });
+    report("make_shared<Widget>", n, true, [](size_t i){
+        return std::make_shared<Widget>(int(i));
+    });
+    /* Only a weak_ptr survives: the Widget is destroyed, but the control block must stay. */
+    report("weak_ptr after shared_ptr(new)", n, false, [](size_t i){
+        return std::weak_ptr<Widget>(std::shared_ptr<Widget>(new Widget(int(i))));
+    });
+    /* With make_shared the Widget lives in the control block's allocation, so it is not freed either. */
+    report("weak_ptr after make_shared", n, false, [](size_t i){
+        return std::weak_ptr<Widget>(std::make_shared<Widget>(int(i)));
+    });
+    return 0;
+}
@@ -1,31 +1,76 @@
 #include "item22_widget.h"
-#include "item22_gadget.h"
-#include <string>
-#include <vector>
 #include <iostream>
-struct Widget::Impl{
-    std::string name;
-    std::vector<double> data;
-    Gadget g1, g2, g3;
-};
-
-Widget::Widget():pImpl(std::make_unique<Impl>()){
-}
-
-Widget::~Widget() = default;
+#include <vector>
+#include <chrono>
+#include <atomic>
+#include <thread>
 
-/* move series construct */
-Widget::Widget(Widget&& rhs) = default;
-Widget& Widget::operator=(Widget&& rhs) =default;
-/* copy series construct */
-Widget::Widget(const Widget& rhs):pImpl(std::make_unique<Impl>(*rhs.pImpl)) {}
-Widget& Widget::operator=(const Widget& rhs){
-    *pImpl = *rhs.pImpl;
-    return *this;
-}
+/* Widget, FastWidget and CowWidget are implemented in item22_widget_impl.cpp */
 int main(){
     Widget w;
     Widget w2 = std::move(w);
 	w.pImpl_empty();
+	std::cout << std::endl;
+
+    /* create-and-copy per request: unique_ptr pimpl vs. in-place pimpl */
+    const int n = 1000000;
+    auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < n; i++){
+        Widget w3;
+        Widget w4(w3);
+    }
+    auto pimplTime = std::chrono::steady_clock::now() - start;
+    start = std::chrono::steady_clock::now();
+    for(int i = 0; i < n; i++){
+        FastWidget w3;
+        FastWidget w4(w3);
+    }
+    auto fastTime = std::chrono::steady_clock::now() - start;
+    using std::chrono::duration_cast;
+    using std::chrono::milliseconds;
+    std::cout << "sizeof(Widget) : " << sizeof(Widget) << ", sizeof(FastWidget) : " << sizeof(FastWidget) << std::endl;
+    std::cout << n << " x (construct + copy) Widget : " << duration_cast<milliseconds>(pimplTime).count()
+              << " ms, FastWidget : " << duration_cast<milliseconds>(fastTime).count() << " ms" << std::endl;
+
+    /* copy-on-write: readers on many threads share one Impl while a writer detaches its own copy */
+    CowWidget original;
+    original.setName("original");
+    for(int i = 0; i < 100000; i++){
+        original.addData(i);
+    }
+    double expected = 0;
+    for(std::size_t i = 0; i < original.dataSize(); i++){
+        expected += original.dataAt(i);
+    }
+    std::atomic<int> mismatches{0};
+    std::vector<std::thread> readers;
+    for(int t = 0; t < 4; t++){
+        readers.emplace_back([&original, &mismatches, expected]{
+            for(int round = 0; round < 20; round++){
+                CowWidget copy(original);
+                double sum = 0;
+                for(std::size_t i = 0; i < copy.dataSize(); i++){
+                    sum += copy.dataAt(i);
+                }
+                if(sum != expected || !copy.sharesImplWith(original) || copy.name() != "original"){
+                    ++mismatches;
+                }
+            }
+        });
+    }
+    CowWidget writer(original);
+    for(int round = 0; round < 20; round++){
+        writer.addData(1.0);
+        writer.setName("writer");
+    }
+    for(auto& t : readers){
+        t.join();
+    }
+    std::cout << "CowWidget : " << mismatches << " reader mismatches, writer detached : "
+              << !writer.sharesImplWith(original) << ", writer size : " << writer.dataSize()
+              << ", original size : " << original.dataSize() << std::endl;
+    if(mismatches != 0 || writer.sharesImplWith(original) || original.dataSize() != 100000){
+        return 1;
+    }
 	return 0;
 }
\ No newline at end of file
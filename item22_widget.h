@@ -1,6 +1,8 @@
 #pragma once
 #include <memory>
 #include <iostream>
+#include <cstddef>
+#include <string>
 using namespace std;
 
 class Widget{
@@ -13,6 +15,13 @@ public:
     Widget(const Widget& rhs);
     Widget& operator=(Widget&& rhs);
 
+    const std::string& name() const;
+    std::size_t dataSize() const;
+    double dataAt(std::size_t i) const;
+
+    void setName(std::string newName);
+    void addData(double value);
+
 	auto pImpl_empty() {
 		if(pImpl.get() == nullptr) {
 			std::cout << "empty";
@@ -22,4 +31,65 @@ public:
 private:
     struct Impl;
     std::unique_ptr<Impl> pImpl;
-};
\ No newline at end of file
+};
+
+/*
+    Fast pimpl: the same compile firewall, but Impl is constructed in place in an aligned buffer inside
+    the object instead of on the heap, so there is no allocation per FastWidget and no pointer to chase.
+    The price is that ImplSize has to be kept >= sizeof(Impl) by hand; widget.cpp static_asserts it, so
+    growing Impl past the buffer is a compile error there rather than a silent overflow.
+*/
+class FastWidget{
+public:
+    FastWidget();
+    ~FastWidget();
+
+    FastWidget(FastWidget&& rhs) noexcept;
+    FastWidget& operator=(const FastWidget& rhs);
+    FastWidget(const FastWidget& rhs);
+    FastWidget& operator=(FastWidget&& rhs) noexcept;
+
+    const std::string& name() const;
+    std::size_t dataSize() const;
+    double dataAt(std::size_t i) const;
+
+    void setName(std::string newName);
+    void addData(double value);
+
+private:
+    struct Impl;
+    Impl& impl() noexcept;
+    const Impl& impl() const noexcept;
+
+    static constexpr std::size_t ImplSize = 96;
+    static constexpr std::size_t ImplAlign = alignof(std::max_align_t);
+    alignas(ImplAlign) unsigned char storage[ImplSize];
+};
+
+/*
+    Copy-on-write pimpl: copies share one Impl and only a mutating call makes a private copy of it, so
+    copies that are never modified cost a reference count increment instead of a deep copy of data.
+    As item22_pimpl.cpp explains, with std::shared_ptr the compiler-generated destructor and move/copy
+    operations are fine with an incomplete Impl, so none of them need to be declared here.
+
+    Any number of threads may read CowWidgets that share an Impl; a single CowWidget object must still
+    not be mutated while another thread uses that same object.
+*/
+class CowWidget{
+public:
+    CowWidget();
+
+    const std::string& name() const;
+    std::size_t dataSize() const;
+    double dataAt(std::size_t i) const;
+
+    void setName(std::string newName);
+    void addData(double value);
+
+    bool sharesImplWith(const CowWidget& rhs) const noexcept { return pImpl == rhs.pImpl; }
+
+private:
+    struct Impl;
+    Impl& mutableImpl();
+    std::shared_ptr<Impl> pImpl;
+};
@@ -0,0 +1,146 @@
+#include "item22_widget.h"
+#include "item22_gadget.h"
+#include <string>
+#include <vector>
+#include <iostream>
+#include <new>
+#include <atomic>
+#include "small_vector.hpp"
+
+/* Widgets usually carry a handful of values: keep up to four inline, without a heap allocation */
+using WidgetData = small_vector<double, 4>;
+
+struct Widget::Impl{
+    std::string name;
+    WidgetData data;
+    Gadget g1, g2, g3;
+};
+
+Widget::Widget():pImpl(std::make_unique<Impl>()){
+}
+
+Widget::~Widget() = default;
+
+/* move series construct */
+Widget::Widget(Widget&& rhs) = default;
+Widget& Widget::operator=(Widget&& rhs) =default;
+/* copy series construct */
+Widget::Widget(const Widget& rhs):pImpl(std::make_unique<Impl>(*rhs.pImpl)) {}
+Widget& Widget::operator=(const Widget& rhs){
+    *pImpl = *rhs.pImpl;
+    return *this;
+}
+
+const std::string& Widget::name() const{
+    return pImpl->name;
+}
+std::size_t Widget::dataSize() const{
+    return pImpl->data.size();
+}
+double Widget::dataAt(std::size_t i) const{
+    return pImpl->data[i];
+}
+void Widget::setName(std::string newName){
+    pImpl->name = std::move(newName);
+}
+void Widget::addData(double value){
+    pImpl->data.push_back(value);
+}
+
+/* fast pimpl: Impl lives in FastWidget::storage */
+struct FastWidget::Impl{
+    std::string name;
+    WidgetData data;
+    Gadget g1, g2, g3;
+};
+
+FastWidget::Impl& FastWidget::impl() noexcept{
+    /* Impl is private, so the buffer checks live in a member */
+    static_assert(sizeof(Impl) <= ImplSize, "FastWidget::ImplSize is too small for Impl");
+    static_assert(alignof(Impl) <= ImplAlign, "FastWidget::ImplAlign is too weak for Impl");
+    return *std::launder(reinterpret_cast<Impl*>(storage));
+}
+const FastWidget::Impl& FastWidget::impl() const noexcept{
+    return *std::launder(reinterpret_cast<const Impl*>(storage));
+}
+
+FastWidget::FastWidget(){
+    new (storage) Impl();
+}
+
+FastWidget::~FastWidget(){
+    impl().~Impl();
+}
+
+/* move series construct, the moved-from FastWidget keeps a valid (moved-from) Impl */
+FastWidget::FastWidget(FastWidget&& rhs) noexcept{
+    new (storage) Impl(std::move(rhs.impl()));
+}
+FastWidget& FastWidget::operator=(FastWidget&& rhs) noexcept{
+    impl() = std::move(rhs.impl());
+    return *this;
+}
+/* copy series construct */
+FastWidget::FastWidget(const FastWidget& rhs){
+    new (storage) Impl(rhs.impl());
+}
+FastWidget& FastWidget::operator=(const FastWidget& rhs){
+    impl() = rhs.impl();
+    return *this;
+}
+
+const std::string& FastWidget::name() const{
+    return impl().name;
+}
+std::size_t FastWidget::dataSize() const{
+    return impl().data.size();
+}
+double FastWidget::dataAt(std::size_t i) const{
+    return impl().data[i];
+}
+void FastWidget::setName(std::string newName){
+    impl().name = std::move(newName);
+}
+void FastWidget::addData(double value){
+    impl().data.push_back(value);
+}
+
+
+/* copy-on-write pimpl: Impl is shared until someone writes */
+struct CowWidget::Impl{
+    std::string name;
+    WidgetData data;
+    Gadget g1, g2, g3;
+};
+
+CowWidget::CowWidget():pImpl(std::make_shared<Impl>()){}
+
+const std::string& CowWidget::name() const{
+    return pImpl->name;
+}
+std::size_t CowWidget::dataSize() const{
+    return pImpl->data.size();
+}
+double CowWidget::dataAt(std::size_t i) const{
+    return pImpl->data[i];
+}
+
+void CowWidget::setName(std::string newName){
+    mutableImpl().name = std::move(newName);
+}
+void CowWidget::addData(double value){
+    mutableImpl().data.push_back(value);
+}
+
+/*
+    If we hold the only reference nobody else can start sharing it (that would mean copying *this, which
+    is our own object), so we may write in place. use_count() is a relaxed load; the acquire fence pairs
+    with the release in the last other owner's decrement, so its reads of Impl happen before our writes.
+ */
+CowWidget::Impl& CowWidget::mutableImpl(){
+    if(pImpl.use_count() != 1){
+        pImpl = std::make_shared<Impl>(*pImpl);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return *pImpl;
+}
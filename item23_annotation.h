@@ -0,0 +1,16 @@
+#pragma once
+#include <string>
+#include <utility>
+
+/*
+    The Annotation of item23. text is declared const, so std::move(text) is a const rvalue and value is
+    copy-constructed from it: move requests on const objects are silently transformed into copies.
+    Annotation's own move operations are the compiler-generated ones.
+*/
+class Annotation{
+public:
+    explicit Annotation(const std::string text): value(std::move(text)) {}
+    const std::string& text() const noexcept { return value; }
+private:
+    std::string value;
+};
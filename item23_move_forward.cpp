@@ -1,4 +1,6 @@
 #include "type_name.hpp"
+#include "item23_annotation.h"
+#include "item23_widget.h"
 #include <chrono>
 #include <iostream>
 // #include <typeinfo>
@@ -173,12 +175,8 @@ template <typename T> decltype(auto) move(T &&param) {
 
 // };
 
-class Widget {
-public:
-  Widget() = default;
-  Widget(const Widget &w) { std::cout << "Copy constructor is called \n"; }
-  Widget(Widget &&other) { std::cout << "Move constructor is called \n"; }
-};
+using item23::Widget;
+
 void process(const Widget &lvalArg) {
   std::cout << "process via lvalue reference \n";
 }
@@ -224,4 +222,8 @@ int main() {
   /* Test rvalue */
   auto z = move1(1);
   std::cout << "type of t : " << type_name<decltype(t)>() << std::endl;
+
+  /* Annotation's constructor applies std::move to a const std::string, so value is copy-constructed */
+  Annotation a(std::string("annotation text"));
+  std::cout << "a.text() : " << a.text() << std::endl;
 }
\ No newline at end of file
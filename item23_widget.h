@@ -0,0 +1,17 @@
+#pragma once
+#include <iostream>
+
+/*
+    The Widget of item23, which reports which of its constructors ran. Its move constructor is not
+    noexcept, so containers growing a vector of them copy instead of moving (see item29).
+*/
+namespace item23 {
+
+class Widget {
+public:
+  Widget() = default;
+  Widget(const Widget &w) { std::cout << "Copy constructor is called \n"; }
+  Widget(Widget &&other) { std::cout << "Move constructor is called \n"; }
+};
+
+} // namespace item23
@@ -2,6 +2,7 @@
 #include <memory>
 
 #include "type_name.hpp"
+#include "item25_widget.h"
 
 /*
     Difference between rvalue reference and universal reference is that: Rvalue
@@ -169,28 +170,8 @@
 
 */
 using namespace std;
-class SomeDataStructure {
-  SomeDataStructure(SomeDataStructure &&rhs) {
-    cout << "Invoke from SomeDataStructure via rvalue reference \n";
-  };
-};
-
-class Widget {
-public:
-  Widget(string &s) : name(s) {}
-  Widget(const Widget &other) : name(other.name), p(other.p) {
-    std::cout << "Copy constructor \n";
-  }
-
-  Widget(Widget &&rhs) : name(std::move(rhs.name)), p(std::move(rhs.p)) {
-    cout << "Invoke from Widget via rvalue reference \n";
-  }
-  string getName() { return name; }
-
-private:
-  string name;
-  shared_ptr<SomeDataStructure> p;
-};
+using item25::SomeDataStructure;
+using item25::Widget;
 
 Widget makeWidget() {
   string s("zzz");
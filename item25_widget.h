@@ -0,0 +1,35 @@
+#pragma once
+#include <iostream>
+#include <memory>
+#include <string>
+
+/*
+    The Widget of item25, in its own namespace so item_move_guard can check its move operations next to
+    the other items' Widgets.
+*/
+namespace item25 {
+
+class SomeDataStructure {
+  SomeDataStructure(SomeDataStructure &&rhs) {
+    std::cout << "Invoke from SomeDataStructure via rvalue reference \n";
+  };
+};
+
+class Widget {
+public:
+  Widget(std::string &s) : name(s) {}
+  Widget(const Widget &other) : name(other.name), p(other.p) {
+    std::cout << "Copy constructor \n";
+  }
+
+  Widget(Widget &&rhs) : name(std::move(rhs.name)), p(std::move(rhs.p)) {
+    std::cout << "Invoke from Widget via rvalue reference \n";
+  }
+  std::string getName() { return name; }
+
+private:
+  std::string name;
+  std::shared_ptr<SomeDataStructure> p;
+};
+
+} // namespace item25
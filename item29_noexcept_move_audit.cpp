@@ -0,0 +1,117 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <type_traits>
+#include "item17_string_table.h"
+#include "item22_widget.h"
+#include "item23_annotation.h"
+#include "item23_widget.h"
+#include "item25_widget.h"
+
+using namespace std;
+
+/*
+    item29: std::vector only moves its elements into a grown buffer when the move constructor is
+    noexcept (or when there is no copy constructor at all); otherwise it keeps the strong exception
+    guarantee by copying. item23's and item25's Widget(Widget&&) are not noexcept, so a vector of
+    them copies every element on every reallocation.
+
+    Part 1 is a compile-time trait report. The static_asserts pin the types that must keep a nothrow
+    move - if one of them loses it, this file stops compiling - and the table lists all of them.
+    Part 2 grows a std::vector of each type to 1M elements with push_back and counts how many elements
+    reallocation copied and how many it moved.
+*/
+
+/* Part 1: traits */
+static_assert(std::is_nothrow_move_constructible<StringTable>::value, "StringTable move must be noexcept");
+static_assert(std::is_nothrow_move_constructible<ArenaStringTable>::value, "ArenaStringTable move must be noexcept");
+static_assert(std::is_nothrow_move_constructible<FastWidget>::value, "FastWidget move must be noexcept");
+static_assert(std::is_nothrow_move_constructible<CowWidget>::value, "CowWidget move must be noexcept");
+static_assert(std::is_nothrow_move_constructible<Annotation>::value, "Annotation move must be noexcept");
+
+template<typename T>
+void traitRow(const string& name){
+    bool nothrow = std::is_nothrow_move_constructible<T>::value;
+    bool copyable = std::is_copy_constructible<T>::value;
+    const char* growth = (nothrow || !copyable) ? "moves" : "COPIES";
+    cout << left << setw(22) << name << right
+         << setw(10) << (nothrow ? "yes" : "NO")
+         << setw(10) << (copyable ? "yes" : "no")
+         << setw(16) << growth << endl;
+}
+
+/* Part 2: counting what reallocation does. Probe<T> holds a T next to a counter whose copy and move
+   operations count; its own special members are the implicit ones, so it is nothrow-movable and
+   copyable exactly when T is. */
+template<typename T>
+struct OpCounter{
+    static inline size_t copies = 0;
+    static inline size_t moves = 0;
+    OpCounter() = default;
+    OpCounter(const OpCounter&) noexcept { ++copies; }
+    OpCounter(OpCounter&&) noexcept { ++moves; }
+    OpCounter& operator=(const OpCounter&) noexcept { ++copies; return *this; }
+    OpCounter& operator=(OpCounter&&) noexcept { ++moves; return *this; }
+};
+
+template<typename T>
+struct Probe{
+    T value;
+    OpCounter<T> counter;
+};
+
+constexpr size_t elementCount = 1000000;
+
+template<typename T, typename Make>
+void growthRow(const string& name, Make make){
+    OpCounter<T>::copies = 0;
+    OpCounter<T>::moves = 0;
+    std::streambuf* out = cout.rdbuf(nullptr); // item23/item25 Widgets print from their constructors
+    auto start = std::chrono::steady_clock::now();
+    {
+        vector<Probe<T>> v;
+        for(size_t i = 0; i < elementCount; i++){
+            v.push_back(Probe<T>{make(), {}});
+        }
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    cout.rdbuf(out);
+    cout.clear();
+
+    /* push_back of the temporary itself is one move per element, the rest is reallocation */
+    size_t relocMoves = OpCounter<T>::moves - elementCount;
+    size_t relocCopies = OpCounter<T>::copies;
+    cout << left << setw(22) << name << right
+         << setw(14) << relocMoves << setw(14) << relocCopies
+         << setw(10) << elapsed.count()
+         << "   " << (relocCopies ? "reallocation COPIED" : "reallocation moved") << endl;
+}
+
+int main(){
+    cout << "noexcept move trait report" << endl;
+    cout << left << setw(22) << "type" << right << setw(10) << "nothrow" << setw(10) << "copyable"
+         << setw(16) << "vector growth" << endl;
+    traitRow<StringTable>("StringTable");
+    traitRow<ArenaStringTable>("ArenaStringTable");
+    traitRow<Widget>("item22 Widget");
+    traitRow<FastWidget>("item22 FastWidget");
+    traitRow<CowWidget>("item22 CowWidget");
+    traitRow<item23::Widget>("item23 Widget");
+    traitRow<Annotation>("item23 Annotation");
+    traitRow<item25::Widget>("item25 Widget");
+
+    cout << endl << "vector<T> grown to " << elementCount << " elements by push_back" << endl;
+    cout << left << setw(22) << "type" << right << setw(14) << "moved" << setw(14) << "copied"
+         << setw(10) << "ms" << endl;
+    growthRow<StringTable>("StringTable", []{ return StringTable(); });
+    growthRow<ArenaStringTable>("ArenaStringTable", []{ return ArenaStringTable(); });
+    growthRow<Widget>("item22 Widget", []{ Widget w; w.setName("widget"); return w; });
+    growthRow<FastWidget>("item22 FastWidget", []{ FastWidget w; w.setName("widget"); return w; });
+    growthRow<CowWidget>("item22 CowWidget", []{ CowWidget w; w.setName("widget"); return w; });
+    growthRow<item23::Widget>("item23 Widget", []{ return item23::Widget(); });
+    growthRow<Annotation>("item23 Annotation", []{ return Annotation("annotation"); });
+    growthRow<item25::Widget>("item25 Widget", []{ string s("widget"); return item25::Widget(s); });
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include <iostream>
+#include <iomanip>
+#include <array>
+#include <chrono>
+#include <new>
+#include <string>
+#include <vector>
+#include "small_vector.hpp"
+
+using namespace std;
+
+/*
+    Numbers for item29's claims, measured on the standard library this is built with.
+
+    1. std::string, length 0..64: with the SSO a short string lives inside the object, so moving it is a
+       copy of the buffer and no faster than copying; past the SSO capacity a copy allocates and a move
+       steals the pointer. The crossover is the first length whose copy needs the heap.
+    2. std::array, std::vector, small_vector over element counts: array moves are linear like its copies,
+       vector moves are constant, small_vector moves are linear while inline and constant after that.
+
+    All numbers are nanoseconds per construction (copy-construct a, or move-construct from a), averaged
+    over many rounds. Build with optimisation (-DCMAKE_BUILD_TYPE=Release) for numbers worth publishing.
+*/
+
+using Clock = std::chrono::steady_clock;
+
+/* Keep the compiler from deleting the work we are timing. */
+template<typename T>
+inline void doNotOptimize(T& value){
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+template<typename T>
+double copyNs(const T& source, int rounds){
+    auto start = Clock::now();
+    for(int i = 0; i < rounds; i++){
+        T copy(source);
+        doNotOptimize(copy);
+    }
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / rounds;
+}
+
+/* Move out and back in, so every round starts from the same full object: two moves per round. */
+template<typename T>
+double moveNs(T& source, int rounds){
+    auto start = Clock::now();
+    for(int i = 0; i < rounds; i++){
+        T tmp(std::move(source));
+        doNotOptimize(tmp);
+        source.~T();
+        ::new (static_cast<void*>(&source)) T(std::move(tmp));
+        doNotOptimize(source);
+    }
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / rounds / 2;
+}
+
+bool storedInline(const string& s){
+    auto p = reinterpret_cast<const char*>(s.data());
+    auto obj = reinterpret_cast<const char*>(&s);
+    return p >= obj && p < obj + sizeof(s);
+}
+
+template<size_t Count>
+void arrayRow(int rounds){
+    array<int, Count> ints{};
+    array<string, Count> strings;
+    strings.fill(string(32, 's'));
+    cout << setw(8) << Count
+         << setw(12) << copyNs(ints, rounds) << setw(12) << moveNs(ints, rounds)
+         << setw(12) << copyNs(strings, rounds) << setw(12) << moveNs(strings, rounds) << endl;
+}
+
+void containerRow(size_t count, int rounds){
+    vector<int> v(count, 1);
+    small_vector<int, 16> sv(count, 1);
+    cout << setw(8) << count
+         << setw(12) << copyNs(v, rounds) << setw(12) << moveNs(v, rounds)
+         << setw(12) << copyNs(sv, rounds) << setw(12) << moveNs(sv, rounds)
+         << setw(10) << (sv.is_inline() ? "inline" : "heap") << endl;
+}
+
+int main(){
+    const int rounds = 200000;
+    cout << fixed << setprecision(1);
+
+    cout << "std::string, sizeof " << sizeof(string) << endl;
+    cout << setw(8) << "length" << setw(12) << "copy ns" << setw(12) << "move ns" << setw(10) << "storage" << endl;
+    size_t crossover = 0;
+    for(size_t len = 0; len <= 64; len++){
+        string s(len, 'x');
+        bool inlined = storedInline(s);
+        if(!inlined && crossover == 0) crossover = len;
+        cout << setw(8) << len << setw(12) << copyNs(s, rounds) << setw(12) << moveNs(s, rounds)
+             << setw(10) << (inlined ? "SSO" : "heap") << endl;
+    }
+    cout << "SSO capacity : " << string().capacity() << " chars, copies allocate from length " << crossover << endl;
+
+    cout << endl << "std::array (linear to copy and to move)" << endl;
+    cout << setw(8) << "count" << setw(12) << "int copy" << setw(12) << "int move"
+         << setw(12) << "str copy" << setw(12) << "str move" << endl;
+    arrayRow<1>(rounds);
+    arrayRow<16>(rounds / 10);
+    arrayRow<256>(rounds / 100);
+    arrayRow<4096>(rounds / 1000);
+
+    cout << endl << "std::vector<int> vs small_vector<int, 16>" << endl;
+    cout << setw(8) << "count" << setw(12) << "vec copy" << setw(12) << "vec move"
+         << setw(12) << "sv copy" << setw(12) << "sv move" << setw(10) << "sv data" << endl;
+    for(size_t count : {0, 2, 8, 16, 17, 256, 4096}){
+        containerRow(count, count > 256 ? rounds / 100 : rounds);
+    }
+    return 0;
+}
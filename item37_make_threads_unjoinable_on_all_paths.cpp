@@ -3,6 +3,7 @@
 #include <vector>
 #include <functional>
 #include "type_name.hpp"
+#include "small_vector.hpp"
 
 using namespace std;
 
@@ -17,8 +18,10 @@ using namespace std;
    and underlying thread of execution it corresponds to.
 */
 constexpr auto tenMillion = 10000000;
+/* Selective filters keep only a few values: those stay inline, a permissive one spills to the heap. */
+using GoodValsType = small_vector<int, 16>;
 bool doWork(std::function<bool(int)> filter, int maxVal = tenMillion){
-    std::vector<int> goodVals;
+    GoodValsType goodVals;
     std::thread t([&filter, maxVal, &goodVals]{
         for (auto i = 0;  i < maxVal; i++){
             if(filter(i)) goodVals.push_back(i);
@@ -80,7 +83,7 @@ private:
 };
 /* Refine doWork */
 bool doWork1(std::function<bool(int)> filter, int maxVal = tenMillion/1000){
-    std::vector<int> goodVals;
+    GoodValsType goodVals;
     ThreadRAII t(
         std::thread([&filter, maxVal, &goodVals]{
             for(auto i = 0; i < maxVal; ++i)
@@ -3,6 +3,7 @@
 #include <vector>
 #include <unordered_map>
 #include <functional>
+#include "item5_dwim_parallel.h"
 
 using namespace std;
 
@@ -43,6 +44,11 @@ int main(){
     vector<int> v{1,2,3,4};
     dwim(v.begin(), v.end());
     dwimNew(v.begin(), v.end());
+    // The same walk spread over a thread pool; f runs concurrently, so it
+    // changes elements instead of printing them.
+    dwim_parallel(v.begin(), v.end(), [](int& x){ x *= 10; });
+    dwim(v.begin(), v.end());
+    dwim_parallel(v.begin(), v.end(), [](int& x){ x /= 10; });
 
     // some test on unique_ptr.
     int i = 5;
@@ -0,0 +1,190 @@
+#pragma once
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/*
+    item5's dwim walks [b, e) on the calling thread. dwim_parallel(b, e, f) calls f(*it) for every element
+    the same way, but spreads the calls over a pool of threads, choosing how by the iterator category:
+
+        random access   [b, e) is cut into chunks of roughly equal size up front, one task each;
+        forward         the calling thread walks the range and hands out batches of iterators as it
+                        goes, so the walk overlaps with the work on earlier batches (a pipeline); at
+                        most a few batches per worker are in flight at once;
+        input           single pass, nothing can be handed out: it runs serially like dwim.
+
+    f must be safe to call concurrently on different elements. The first exception thrown by f is
+    rethrown by dwim_parallel after every task has finished. A dwim_parallel called from inside a pool
+    task runs serially, so nested calls never block a worker waiting for other workers.
+*/
+
+class DwimPool{
+public:
+    /* at least one worker: with none, submitted tasks would never run */
+    explicit DwimPool(std::size_t threads = defaultThreads()){
+        threads = std::max<std::size_t>(threads, 1);
+        workers.reserve(threads);
+        for(std::size_t i = 0; i < threads; i++) workers.emplace_back([this]{ run(); });
+    }
+    ~DwimPool(){
+        {
+            std::lock_guard<std::mutex> g(m);
+            stopping = true;
+        }
+        cv.notify_all();
+        for(auto& t : workers) t.join();
+    }
+    DwimPool(const DwimPool&) = delete;
+    DwimPool& operator=(const DwimPool&) = delete;
+
+    /* the pool dwim_parallel uses when none is given */
+    static DwimPool& shared(){
+        static DwimPool pool;
+        return pool;
+    }
+    static std::size_t defaultThreads() noexcept { return std::max(1u, std::thread::hardware_concurrency()); }
+
+    std::size_t size() const noexcept { return workers.size(); }
+    static bool onWorkerThread() noexcept { return insideTask(); }
+
+    template<typename F>
+    std::future<void> submit(F task){
+        auto job = std::make_shared<std::packaged_task<void()>>(std::move(task));
+        std::future<void> done = job->get_future();
+        {
+            std::lock_guard<std::mutex> g(m);
+            queue.emplace_back([job]{ (*job)(); });
+        }
+        cv.notify_one();
+        return done;
+    }
+
+private:
+    static bool& insideTask() noexcept{
+        thread_local bool inside = false;
+        return inside;
+    }
+
+    void run(){
+        insideTask() = true;
+        for(;;){
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lk(m);
+                cv.wait(lk, [this]{ return stopping || !queue.empty(); });
+                if(queue.empty()) return;
+                job = std::move(queue.front());
+                queue.pop_front();
+            }
+            job(); // packaged_task keeps exceptions in the future
+        }
+    }
+
+    std::mutex m;
+    std::condition_variable cv;
+    std::deque<std::function<void()>> queue;
+    bool stopping = false;
+    std::vector<std::thread> workers; // last, so it starts after the members it uses (item37)
+};
+
+namespace dwim_detail{
+
+/* random access chunks smaller than this are not worth a task */
+constexpr std::ptrdiff_t minChunk = 1024;
+/* iterators per batch for forward ranges */
+constexpr std::size_t batchSize = 512;
+
+/*
+    Wait for every task, then rethrow the first exception. Tasks hold f by reference, so this also runs
+    before an exception from the walk itself leaves the frame f lives in.
+*/
+template<typename Futures>
+void waitAll(Futures& pending){
+    std::exception_ptr first;
+    for(auto& f : pending){
+        try{
+            f.get();
+        }catch(...){
+            if(!first) first = std::current_exception();
+        }
+    }
+    pending.clear();
+    if(first) std::rethrow_exception(first);
+}
+
+template<typename It, typename F>
+void serial(It b, It e, F& f){
+    for(; b != e; ++b) f(*b);
+}
+
+template<typename It, typename F>
+void run(DwimPool&, It b, It e, F& f, std::input_iterator_tag){
+    serial(b, e, f);
+}
+
+template<typename It, typename F>
+void run(DwimPool& pool, It b, It e, F& f, std::forward_iterator_tag){
+    const std::size_t maxInFlight = 2 * pool.size();
+    std::deque<std::future<void>> inFlight;
+    try{
+        while(b != e){
+            auto batch = std::make_shared<std::vector<It>>();
+            batch->reserve(batchSize);
+            for(; b != e && batch->size() < batchSize; ++b) batch->push_back(b);
+            if(inFlight.size() == maxInFlight){
+                inFlight.front().get();
+                inFlight.pop_front();
+            }
+            inFlight.push_back(pool.submit([batch, &f]{
+                for(auto it : *batch) f(*it);
+            }));
+        }
+    }catch(...){
+        try{ waitAll(inFlight); }catch(...){}
+        throw;
+    }
+    waitAll(inFlight);
+}
+
+template<typename It, typename F>
+void run(DwimPool& pool, It b, It e, F& f, std::random_access_iterator_tag){
+    auto n = e - b;
+    /* a few chunks per worker, so one slow chunk does not leave the others idle at the end */
+    auto chunks = std::min<std::ptrdiff_t>(static_cast<std::ptrdiff_t>(4 * pool.size()), n / minChunk);
+    if(chunks <= 1) return serial(b, e, f);
+    std::vector<std::future<void>> pending;
+    pending.reserve(static_cast<std::size_t>(chunks));
+    try{
+        for(std::ptrdiff_t c = 0; c < chunks; c++){
+            It first = b + n * c / chunks, last = b + n * (c + 1) / chunks;
+            pending.push_back(pool.submit([first, last, &f]{ serial(first, last, f); }));
+        }
+    }catch(...){
+        try{ waitAll(pending); }catch(...){}
+        throw;
+    }
+    waitAll(pending);
+}
+
+} // namespace dwim_detail
+
+template<typename It, typename F>
+void dwim_parallel(DwimPool& pool, It b, It e, F f){
+    if(DwimPool::onWorkerThread()) return dwim_detail::serial(b, e, f);
+    dwim_detail::run(pool, b, e, f, typename std::iterator_traits<It>::iterator_category{});
+}
+
+template<typename It, typename F>
+void dwim_parallel(It b, It e, F f){
+    dwim_parallel(DwimPool::shared(), b, e, std::move(f));
+}
@@ -0,0 +1,111 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "item5_dwim_parallel.h"
+
+using namespace std;
+
+/*
+    "Apply to every element" over a vector<int> (random access: chunks) and an unordered_map<int, int>
+    (forward: pipelined batches), serially as item5's dwim does and through dwim_parallel on pools of
+    1, 2, 4 and 8 threads. Two kinds of f: a light one (one add) where the walk itself dominates, and a
+    heavy one (a few hundred cycles of arithmetic) where the work does. The checksums must match the
+    serial run.
+
+    Usage : ./item5_dwim_parallel_benchmark [vector size] [map size]
+*/
+
+using Clock = std::chrono::steady_clock;
+
+inline void light(int& x){
+    x += 1;
+}
+
+inline void heavy(int& x){
+    auto v = static_cast<std::uint32_t>(x);
+    for(int i = 0; i < 64; i++){
+        v ^= v << 13;
+        v ^= v >> 17;
+        v ^= v << 5;
+    }
+    x = static_cast<int>(v & 0xffff);
+}
+
+long checksum(const vector<int>& v){
+    long sum = 0;
+    for(int x : v) sum += x;
+    return sum;
+}
+
+long checksum(const unordered_map<int, int>& m){
+    long sum = 0;
+    for(auto& p : m) sum += p.second;
+    return sum;
+}
+
+void reset(vector<int>& v){
+    for(size_t i = 0; i < v.size(); i++) v[i] = int(i);
+}
+
+void reset(unordered_map<int, int>& m){
+    for(auto& p : m) p.second = p.first;
+}
+
+template<typename Apply>
+double timeMs(Apply apply){
+    auto start = Clock::now();
+    apply();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+/* serial run first, then each pool; every row is checked against the serial checksum */
+template<typename Container, typename Elem, typename F>
+bool compare(const char* title, Container& c, Elem elem, F f){
+    cout << title << endl;
+    reset(c);
+    double serialMs = timeMs([&]{
+        for(auto it = c.begin(); it != c.end(); ++it) f(elem(*it));
+    });
+    long expected = checksum(c);
+    cout << "  " << left << setw(20) << "serial dwim" << right << setw(10) << serialMs << " ms" << endl;
+
+    bool ok = true;
+    for(size_t threads : {1, 2, 4, 8}){
+        DwimPool pool(threads);
+        reset(c);
+        double ms = timeMs([&]{
+            dwim_parallel(pool, c.begin(), c.end(), [&](auto& e){ f(elem(e)); });
+        });
+        bool good = checksum(c) == expected;
+        ok = ok && good;
+        cout << "  " << left << setw(20) << (to_string(threads) + " threads") << right << setw(10) << ms << " ms"
+             << setw(8) << serialMs / ms << "x" << (good ? "" : "   WRONG RESULT") << endl;
+    }
+    return ok;
+}
+
+int main(int argc, char* argv[]){
+    size_t vectorSize = argc > 1 ? size_t(atol(argv[1])) : 4000000;
+    size_t mapSize = argc > 2 ? size_t(atol(argv[2])) : 500000;
+
+    vector<int> v(vectorSize);
+    unordered_map<int, int> m;
+    m.reserve(mapSize);
+    for(size_t i = 0; i < mapSize; i++) m[int(i)] = 0;
+
+    cout << std::thread::hardware_concurrency() << " hardware threads" << endl;
+    cout << fixed << setprecision(1);
+    auto asIs = [](int& x) -> int& { return x; };
+    auto mapped = [](pair<const int, int>& p) -> int& { return p.second; };
+    bool ok = true;
+    ok = compare("vector<int>, light f", v, asIs, light) && ok;
+    ok = compare("vector<int>, heavy f", v, asIs, heavy) && ok;
+    ok = compare("unordered_map<int, int>, light f", m, mapped, light) && ok;
+    ok = compare("unordered_map<int, int>, heavy f", m, mapped, heavy) && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,452 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/* x86-64 only: the popcount kernel needs _mm256_extract_epi64 and _mm_popcnt_u64 */
+#if defined(__x86_64__)
+    #include <immintrin.h>
+    #define ITEM6_HAVE_AVX2_KERNELS 1
+#else
+    #define ITEM6_HAVE_AVX2_KERNELS 0
+#endif
+
+/*
+    item6's trouble with std::vector<bool>: operator[] returns a std::vector<bool>::reference, so
+    auto r = features(w)[1] deduces the proxy, and the proxy points into a temporary vector that is gone
+    at the end of the statement.
+
+    feature_bitset packs bits into 64-bit words like vector<bool>, but
+        - operator[] on an rvalue (the features(w)[1] case) and on a const bitset returns a plain bool,
+          so auto deduces bool and nothing can dangle;
+        - operator[] on a non-const lvalue returns feature_bitset::reference, a proxy that says what it
+          is: get() reads the bit, the conversion to bool is explicit, assignment writes the bit;
+        - and, or, count and findFirst work a word at a time, with AVX2 kernels picked at run time
+          (built with __attribute__((target("avx2"))) as in item15_point_batch.h) when the CPU has AVX2.
+    Bits past size() in the last word are always zero, so the word operations need no masking.
+
+    feature_view is a read-only, non-owning view of a feature_bitset's words, the way std::string_view is
+    of a string: returning one copies nothing and allocates nothing. It must not outlive its bitset. In
+    builds without NDEBUG every access asserts that the bitset is still alive and has not been
+    reallocated or reassigned since the view was taken.
+*/
+
+namespace bitkernels{
+
+using word = std::uint64_t;
+
+namespace scalar{
+
+inline void andWords(word* dst, const word* src, std::size_t n) noexcept{
+    for(std::size_t i = 0; i < n; i++) dst[i] &= src[i];
+}
+
+inline void orWords(word* dst, const word* src, std::size_t n) noexcept{
+    for(std::size_t i = 0; i < n; i++) dst[i] |= src[i];
+}
+
+inline std::size_t popcount(const word* w, std::size_t n) noexcept{
+    std::size_t count = 0;
+    for(std::size_t i = 0; i < n; i++) count += static_cast<std::size_t>(__builtin_popcountll(w[i]));
+    return count;
+}
+
+/* index of the first non-zero word, or n */
+inline std::size_t firstNonZero(const word* w, std::size_t n) noexcept{
+    std::size_t i = 0;
+    while(i < n && w[i] == 0) ++i;
+    return i;
+}
+
+} // namespace scalar
+
+#if ITEM6_HAVE_AVX2_KERNELS
+/* Four words per iteration; the tail of fewer than four goes through the scalar loop. */
+namespace avx2{
+
+__attribute__((target("avx2")))
+inline void andWords(word* dst, const word* src, std::size_t n) noexcept{
+    std::size_t i = 0;
+    for(; i + 4 <= n; i += 4){
+        auto d = reinterpret_cast<__m256i*>(dst + i);
+        auto s = reinterpret_cast<const __m256i*>(src + i);
+        _mm256_storeu_si256(d, _mm256_and_si256(_mm256_loadu_si256(d), _mm256_loadu_si256(s)));
+    }
+    scalar::andWords(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx2")))
+inline void orWords(word* dst, const word* src, std::size_t n) noexcept{
+    std::size_t i = 0;
+    for(; i + 4 <= n; i += 4){
+        auto d = reinterpret_cast<__m256i*>(dst + i);
+        auto s = reinterpret_cast<const __m256i*>(src + i);
+        _mm256_storeu_si256(d, _mm256_or_si256(_mm256_loadu_si256(d), _mm256_loadu_si256(s)));
+    }
+    scalar::orWords(dst + i, src + i, n - i);
+}
+
+/*
+    Mula's nibble lookup: vpshufb counts the bits of each nibble from a 16-entry table, vpsadbw sums the
+    byte counts into the four 64-bit lanes.
+*/
+__attribute__((target("avx2,popcnt")))
+inline std::size_t popcount(const word* w, std::size_t n) noexcept{
+    const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                           0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0f);
+    __m256i sums = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for(; i + 4 <= n; i += 4){
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w + i));
+        __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(v, low));
+        __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), low));
+        sums = _mm256_add_epi64(sums, _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256()));
+    }
+    auto count = static_cast<std::size_t>(_mm256_extract_epi64(sums, 0) + _mm256_extract_epi64(sums, 1)
+                                          + _mm256_extract_epi64(sums, 2) + _mm256_extract_epi64(sums, 3));
+    for(; i < n; i++) count += static_cast<std::size_t>(_mm_popcnt_u64(w[i]));
+    return count;
+}
+
+__attribute__((target("avx2")))
+inline std::size_t firstNonZero(const word* w, std::size_t n) noexcept{
+    std::size_t i = 0;
+    for(; i + 4 <= n; i += 4){
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w + i));
+        if(!_mm256_testz_si256(v, v)) break;
+    }
+    return i + scalar::firstNonZero(w + i, n - i);
+}
+
+} // namespace avx2
+#endif
+
+inline bool haveAvx2() noexcept{
+#if ITEM6_HAVE_AVX2_KERNELS
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+inline void andWords(word* dst, const word* src, std::size_t n) noexcept{
+#if ITEM6_HAVE_AVX2_KERNELS
+    if(haveAvx2()) return avx2::andWords(dst, src, n);
+#endif
+    scalar::andWords(dst, src, n);
+}
+
+inline void orWords(word* dst, const word* src, std::size_t n) noexcept{
+#if ITEM6_HAVE_AVX2_KERNELS
+    if(haveAvx2()) return avx2::orWords(dst, src, n);
+#endif
+    scalar::orWords(dst, src, n);
+}
+
+inline std::size_t popcount(const word* w, std::size_t n) noexcept{
+#if ITEM6_HAVE_AVX2_KERNELS
+    if(haveAvx2()) return avx2::popcount(w, n);
+#endif
+    return scalar::popcount(w, n);
+}
+
+inline std::size_t firstNonZero(const word* w, std::size_t n) noexcept{
+#if ITEM6_HAVE_AVX2_KERNELS
+    if(haveAvx2()) return avx2::firstNonZero(w, n);
+#endif
+    return scalar::firstNonZero(w, n);
+}
+
+constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+/* index of the first set bit among the words, or npos */
+inline std::size_t findFirstBit(const word* w, std::size_t n) noexcept{
+    std::size_t i = firstNonZero(w, n);
+    return i == n ? npos : i * 64 + static_cast<std::size_t>(__builtin_ctzll(w[i]));
+}
+
+/* index of the first set bit after pos among the first bits bits, or npos (also for pos == npos) */
+inline std::size_t findNextBit(const word* w, std::size_t bits, std::size_t pos) noexcept{
+    if(pos >= bits || ++pos >= bits) return npos;
+    std::size_t i = pos / 64, n = (bits + 63) / 64;
+    word first = w[i] & (~word{0} << (pos % 64));
+    if(first) return i * 64 + static_cast<std::size_t>(__builtin_ctzll(first));
+    std::size_t next = findFirstBit(w + i + 1, n - i - 1);
+    return next == npos ? npos : (i + 1) * 64 + next;
+}
+
+} // namespace bitkernels
+
+#ifndef NDEBUG
+/*
+    Debug-only lifetime tracking between a feature_bitset and its views. The bitset owns a shared
+    generation counter and bumps it whenever its words may move (push_back, assignment); a view keeps a
+    weak_ptr to the counter and the generation it was taken at. A move hands the counter to the new
+    owner along with the words, so views follow the words.
+*/
+class bit_lifetime{
+public:
+    struct ticket{
+        std::weak_ptr<const std::size_t> state;
+        std::size_t generation = 0;
+
+        bool valid() const noexcept{
+            auto s = state.lock();
+            return s && *s == generation;
+        }
+    };
+
+    bit_lifetime():state(std::make_shared<std::size_t>(0)){}
+    bit_lifetime(const bit_lifetime&):bit_lifetime(){}
+    bit_lifetime(bit_lifetime&& other) noexcept:state(std::move(other.state)){}
+    bit_lifetime& operator=(const bit_lifetime&){
+        invalidate();
+        return *this;
+    }
+    bit_lifetime& operator=(bit_lifetime&& other) noexcept{
+        state = std::move(other.state); // our old counter dies with the old words
+        return *this;
+    }
+
+    /* a moved-from bitset that is filled again gets a fresh counter */
+    void invalidate(){
+        if(state) ++*state;
+        else state = std::make_shared<std::size_t>(0);
+    }
+    ticket issue() const noexcept { return state ? ticket{state, *state} : ticket{}; }
+
+private:
+    std::shared_ptr<std::size_t> state;
+};
+#endif
+
+class feature_bitset;
+
+class feature_view{
+public:
+    using word_type = bitkernels::word;
+    static constexpr std::size_t wordBits = 64;
+    static constexpr std::size_t npos = bitkernels::npos;
+
+    feature_view() = default;
+
+    std::size_t size() const noexcept { return n; }
+    bool empty() const noexcept { return n == 0; }
+    std::size_t wordCount() const noexcept { return (n + wordBits - 1) / wordBits; }
+    const word_type* data() const noexcept{
+        check();
+        return words;
+    }
+
+    bool get(std::size_t i) const noexcept{
+        check();
+        return (words[i / wordBits] >> (i % wordBits)) & 1;
+    }
+    bool operator[](std::size_t i) const noexcept { return get(i); }
+    bool at(std::size_t i) const{
+        if(i >= n) throw std::out_of_range("feature_view::at");
+        return get(i);
+    }
+
+    std::size_t count() const noexcept{
+        check();
+        return bitkernels::popcount(words, wordCount());
+    }
+    bool any() const noexcept { return findFirst() != npos; }
+    bool none() const noexcept { return !any(); }
+    std::size_t findFirst() const noexcept{
+        check();
+        return bitkernels::findFirstBit(words, wordCount());
+    }
+    std::size_t findNext(std::size_t pos) const noexcept{
+        check();
+        return bitkernels::findNextBit(words, n, pos);
+    }
+
+private:
+    friend class feature_bitset;
+#ifndef NDEBUG
+    feature_view(const word_type* words, std::size_t n, bit_lifetime::ticket t) noexcept
+        :words(words), n(n), lifetime(std::move(t)){}
+
+    /* an empty view reads no memory, so it stays usable after its bitset is gone */
+    void check() const noexcept{
+        assert((n == 0 || lifetime.valid()) && "feature_view used after its feature_bitset was destroyed or reallocated");
+    }
+#else
+    feature_view(const word_type* words, std::size_t n) noexcept:words(words), n(n){}
+
+    void check() const noexcept {}
+#endif
+
+    const word_type* words = nullptr;
+    std::size_t n = 0;
+#ifndef NDEBUG
+    bit_lifetime::ticket lifetime;
+#endif
+};
+
+class feature_bitset{
+public:
+    using word_type = bitkernels::word;
+    static constexpr std::size_t wordBits = 64;
+    static constexpr std::size_t npos = bitkernels::npos;
+
+    /* The proxy returned by operator[] on a non-const lvalue. */
+    class reference{
+    public:
+        bool get() const noexcept { return (*w & mask) != 0; }
+        explicit operator bool() const noexcept { return get(); }
+
+        reference& operator=(bool value) noexcept{
+            if(value) *w |= mask;
+            else *w &= ~mask;
+            return *this;
+        }
+        reference& operator=(const reference& other) noexcept { return *this = other.get(); }
+        void flip() noexcept { *w ^= mask; }
+
+    private:
+        friend class feature_bitset;
+        reference(word_type* w, word_type mask) noexcept:w(w), mask(mask){}
+
+        word_type* w;
+        word_type mask;
+    };
+
+    feature_bitset() = default;
+    explicit feature_bitset(std::size_t n, bool value = false)
+        :words(wordsFor(n), value ? ~word_type{0} : word_type{0}), n(n){
+        clearTail();
+    }
+    feature_bitset(std::initializer_list<bool> values):words(wordsFor(values.size())), n(values.size()){
+        std::size_t i = 0;
+        for(bool v : values) set(i++, v);
+    }
+    /* copies the bits out of a view */
+    explicit feature_bitset(feature_view v):words(v.data(), v.data() + v.wordCount()), n(v.size()){}
+
+    feature_bitset(const feature_bitset&) = default;
+    feature_bitset& operator=(const feature_bitset&) = default;
+    feature_bitset(feature_bitset&& other) noexcept
+        :words(std::move(other.words)), n(std::exchange(other.n, 0))
+#ifndef NDEBUG
+        , lifetime(std::move(other.lifetime))
+#endif
+    {}
+    feature_bitset& operator=(feature_bitset&& other) noexcept{
+        words = std::move(other.words);
+        n = std::exchange(other.n, 0);
+#ifndef NDEBUG
+        lifetime = std::move(other.lifetime);
+#endif
+        return *this;
+    }
+
+    std::size_t size() const noexcept { return n; }
+    bool empty() const noexcept { return n == 0; }
+    std::size_t wordCount() const noexcept { return words.size(); }
+    const word_type* data() const noexcept { return words.data(); }
+    word_type* data() noexcept { return words.data(); }
+
+    /*
+        A view of the bits: valid until this bitset is destroyed, reassigned or grown by push_back. Only
+        lvalues hand out views; feature_view v = packed::features(w) would dangle, so it does not compile.
+    */
+    feature_view view() const & noexcept{
+#ifndef NDEBUG
+        return {words.data(), n, lifetime.issue()};
+#else
+        return {words.data(), n};
+#endif
+    }
+    feature_view view() const && = delete;
+    operator feature_view() const & noexcept { return view(); }
+    operator feature_view() const && = delete;
+
+    bool get(std::size_t i) const noexcept { return (words[i / wordBits] >> (i % wordBits)) & 1; }
+    bool at(std::size_t i) const{
+        if(i >= n) throw std::out_of_range("feature_bitset::at");
+        return get(i);
+    }
+
+    reference operator[](std::size_t i) & noexcept { return {&words[i / wordBits], maskOf(i)}; }
+    bool operator[](std::size_t i) const & noexcept { return get(i); }
+    bool operator[](std::size_t i) && noexcept { return get(i); }
+
+    feature_bitset& set(std::size_t i, bool value = true) noexcept{
+        (*this)[i] = value;
+        return *this;
+    }
+    feature_bitset& reset(std::size_t i) noexcept { return set(i, false); }
+
+    void push_back(bool value){
+        if(n % wordBits == 0){
+            words.push_back(0);
+#ifndef NDEBUG
+            lifetime.invalidate();
+#endif
+        }
+        ++n;
+        set(n - 1, value);
+    }
+
+    feature_bitset& operator&=(const feature_bitset& rhs){
+        checkSize(rhs, "feature_bitset::operator&=: sizes differ");
+        bitkernels::andWords(words.data(), rhs.words.data(), words.size());
+        return *this;
+    }
+    feature_bitset& operator|=(const feature_bitset& rhs){
+        checkSize(rhs, "feature_bitset::operator|=: sizes differ");
+        bitkernels::orWords(words.data(), rhs.words.data(), words.size());
+        return *this;
+    }
+
+    std::size_t count() const noexcept { return bitkernels::popcount(words.data(), words.size()); }
+    bool any() const noexcept { return findFirst() != npos; }
+    bool none() const noexcept { return !any(); }
+
+    /* index of the first set bit, or npos */
+    std::size_t findFirst() const noexcept { return bitkernels::findFirstBit(words.data(), words.size()); }
+    /* index of the first set bit after pos, or npos */
+    std::size_t findNext(std::size_t pos) const noexcept { return bitkernels::findNextBit(words.data(), n, pos); }
+
+    friend bool operator==(const feature_bitset& lhs, const feature_bitset& rhs) noexcept{
+        return lhs.n == rhs.n && lhs.words == rhs.words;
+    }
+    friend bool operator!=(const feature_bitset& lhs, const feature_bitset& rhs) noexcept { return !(lhs == rhs); }
+
+private:
+    static std::size_t wordsFor(std::size_t bits) noexcept { return (bits + wordBits - 1) / wordBits; }
+    static word_type maskOf(std::size_t i) noexcept { return word_type{1} << (i % wordBits); }
+
+    void clearTail() noexcept{
+        if(n % wordBits) words.back() &= (word_type{1} << (n % wordBits)) - 1;
+    }
+    void checkSize(const feature_bitset& rhs, const char* what) const{
+        if(n != rhs.n) throw std::invalid_argument(what);
+    }
+
+    std::vector<word_type> words;
+    std::size_t n = 0;
+#ifndef NDEBUG
+    bit_lifetime lifetime;
+#endif
+};
+
+inline feature_bitset operator&(feature_bitset lhs, const feature_bitset& rhs){
+    lhs &= rhs;
+    return lhs;
+}
+
+inline feature_bitset operator|(feature_bitset lhs, const feature_bitset& rhs){
+    lhs |= rhs;
+    return lhs;
+}
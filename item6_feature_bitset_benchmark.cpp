@@ -0,0 +1,129 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "item6_feature_bitset.h"
+
+using namespace std;
+
+/*
+    Evaluating feature flags per request: the enabled flags of a request are its user's flags AND the
+    rollout mask OR the forced-on flags; then count them and find the first one.
+
+    std::vector<bool> does that a bit at a time through its proxy; feature_bitset does it a word at a
+    time, with the scalar word loop and the AVX2 kernels timed separately. Every variant must agree with
+    the vector<bool> answer.
+
+    Usage : ./item6_feature_bitset_benchmark [bits] [rounds]
+*/
+
+using Clock = std::chrono::steady_clock;
+
+template<typename T>
+inline void doNotOptimize(const T& value){
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+struct Result{
+    size_t count;
+    size_t first;
+};
+
+Result evalVectorBool(const vector<bool>& user, const vector<bool>& rollout, const vector<bool>& forced){
+    vector<bool> enabled(user.size());
+    for(size_t i = 0; i < user.size(); i++) enabled[i] = (user[i] && rollout[i]) || forced[i];
+    Result r{0, feature_bitset::npos};
+    for(size_t i = 0; i < enabled.size(); i++){
+        if(enabled[i]){
+            if(r.count++ == 0) r.first = i;
+        }
+    }
+    return r;
+}
+
+/* the same steps on feature_bitset words, through either kernel set */
+template<typename Kernels>
+Result evalWords(const feature_bitset& user, const feature_bitset& rollout, const feature_bitset& forced, Kernels k){
+    feature_bitset enabled = user;
+    k.andWords(enabled.data(), rollout.data(), enabled.wordCount());
+    k.orWords(enabled.data(), forced.data(), enabled.wordCount());
+    size_t count = k.popcount(enabled.data(), enabled.wordCount());
+    size_t w = k.firstNonZero(enabled.data(), enabled.wordCount());
+    size_t first = w == enabled.wordCount() ? feature_bitset::npos
+                                            : w * feature_bitset::wordBits + size_t(__builtin_ctzll(enabled.data()[w]));
+    return {count, first};
+}
+
+struct ScalarKernels{
+    void andWords(bitkernels::word* d, const bitkernels::word* s, size_t n) const { bitkernels::scalar::andWords(d, s, n); }
+    void orWords(bitkernels::word* d, const bitkernels::word* s, size_t n) const { bitkernels::scalar::orWords(d, s, n); }
+    size_t popcount(const bitkernels::word* w, size_t n) const { return bitkernels::scalar::popcount(w, n); }
+    size_t firstNonZero(const bitkernels::word* w, size_t n) const { return bitkernels::scalar::firstNonZero(w, n); }
+};
+
+#if ITEM6_HAVE_AVX2_KERNELS
+struct Avx2Kernels{
+    void andWords(bitkernels::word* d, const bitkernels::word* s, size_t n) const { bitkernels::avx2::andWords(d, s, n); }
+    void orWords(bitkernels::word* d, const bitkernels::word* s, size_t n) const { bitkernels::avx2::orWords(d, s, n); }
+    size_t popcount(const bitkernels::word* w, size_t n) const { return bitkernels::avx2::popcount(w, n); }
+    size_t firstNonZero(const bitkernels::word* w, size_t n) const { return bitkernels::avx2::firstNonZero(w, n); }
+};
+#endif
+
+/* the operators, which dispatch on the CPU themselves */
+Result evalOperators(const feature_bitset& user, const feature_bitset& rollout, const feature_bitset& forced){
+    feature_bitset enabled = (user & rollout) | forced;
+    return {enabled.count(), enabled.findFirst()};
+}
+
+template<typename F>
+double nsPerRound(int rounds, F f){
+    auto start = Clock::now();
+    for(int i = 0; i < rounds; i++){
+        Result r = f();
+        doNotOptimize(r);
+    }
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / rounds;
+}
+
+int main(int argc, char* argv[]){
+    size_t bits = argc > 1 ? size_t(atol(argv[1])) : 4096;
+    int rounds = argc > 2 ? atoi(argv[2]) : 1000;
+
+    mt19937 gen(6);
+    bernoulli_distribution userDist(0.5), rolloutDist(0.1), forcedDist(0.0005);
+    vector<bool> user(bits), rollout(bits), forced(bits);
+    feature_bitset userBits(bits), rolloutBits(bits), forcedBits(bits);
+    for(size_t i = 0; i < bits; i++){
+        userBits[i] = user[i] = userDist(gen);
+        rolloutBits[i] = rollout[i] = rolloutDist(gen);
+        forcedBits[i] = forced[i] = forcedDist(gen);
+    }
+
+    Result expected = evalVectorBool(user, rollout, forced);
+    cout << bits << " flags, " << expected.count << " enabled, first at " << expected.first
+         << (bitkernels::haveAvx2() ? "" : " (no AVX2 on this CPU)") << endl;
+    cout << fixed << setprecision(1);
+    bool ok = true;
+    auto row = [&](const char* name, Result r, double ns){
+        bool good = r.count == expected.count && r.first == expected.first;
+        ok = ok && good;
+        cout << "  " << left << setw(28) << name << right << setw(12) << ns << " ns/request"
+             << (good ? "" : "   WRONG RESULT") << endl;
+    };
+
+    row("vector<bool>", expected, nsPerRound(rounds, [&]{ return evalVectorBool(user, rollout, forced); }));
+    row("feature_bitset scalar words", evalWords(userBits, rolloutBits, forcedBits, ScalarKernels{}),
+        nsPerRound(rounds, [&]{ return evalWords(userBits, rolloutBits, forcedBits, ScalarKernels{}); }));
+#if ITEM6_HAVE_AVX2_KERNELS
+    if(bitkernels::haveAvx2()){
+        row("feature_bitset AVX2 words", evalWords(userBits, rolloutBits, forcedBits, Avx2Kernels{}),
+            nsPerRound(rounds, [&]{ return evalWords(userBits, rolloutBits, forcedBits, Avx2Kernels{}); }));
+    }
+#endif
+    row("feature_bitset operators", evalOperators(userBits, rolloutBits, forcedBits),
+        nsPerRound(rounds, [&]{ return evalOperators(userBits, rolloutBits, forcedBits); }));
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,96 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include "item6_feature_bitset.h"
+
+using namespace std;
+
+/*
+    Cost of one feature query through item6's _features_(w)[i]: returning the Widget_'s bits by value
+    copies them, and the copy allocates, on every query; returning a feature_view copies two words (plus,
+    without NDEBUG, the weak_ptr the lifetime check uses) and never allocates.
+
+    The global operator new below counts the allocations per query.
+
+    Usage : ./item6_feature_view_benchmark [flags] [queries]
+*/
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+size_t allocCount = 0;
+}
+
+void* operator new(size_t size){
+    ++allocCount;
+    if(void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept{
+    std::free(p);
+}
+
+struct VectorBoolWidget{
+    vector<bool> v;
+};
+struct BitsetWidget{
+    feature_bitset v;
+};
+
+vector<bool> featuresCopy(const VectorBoolWidget& w){
+    return w.v;
+}
+feature_bitset featuresCopy(const BitsetWidget& w){
+    return w.v;
+}
+feature_view featuresView(const BitsetWidget& w){
+    return w.v;
+}
+
+template<typename F>
+void measure(const char* name, long queries, size_t flags, F query){
+    long enabled = 0;
+    size_t allocsBefore = allocCount;
+    auto start = Clock::now();
+    for(long i = 0; i < queries; i++){
+        enabled += query(size_t(i) % flags);
+    }
+    auto elapsed = Clock::now() - start;
+    size_t allocs = allocCount - allocsBefore;
+    cout << "  " << left << setw(28) << name << right
+         << setw(10) << std::chrono::duration<double, std::nano>(elapsed).count() / queries << " ns/query"
+         << setw(8) << double(allocs) / queries << " allocs/query"
+         << "   (" << enabled << " enabled)" << endl;
+}
+
+int main(int argc, char* argv[]){
+    size_t flags = argc > 1 ? size_t(atol(argv[1])) : 256;
+    long queries = argc > 2 ? atol(argv[2]) : 1000000;
+
+    VectorBoolWidget vw;
+    BitsetWidget bw;
+    for(size_t i = 0; i < flags; i++){
+        vw.v.push_back(i % 3 == 0);
+        bw.v.push_back(i % 3 == 0);
+    }
+
+    cout << flags << " flags, " << queries << " queries"
+#ifndef NDEBUG
+         << " (lifetime checks on)"
+#endif
+         << endl;
+    cout << fixed << setprecision(1);
+    // -> bool matters here: deduced, the lambda would return a vector<bool>::reference into the copy
+    measure("vector<bool> by value", queries, flags, [&](size_t i) -> bool { return featuresCopy(vw)[i]; });
+    measure("feature_bitset by value", queries, flags, [&](size_t i){ return featuresCopy(bw)[i]; });
+    measure("feature_view", queries, flags, [&](size_t i){ return featuresView(bw)[i]; });
+    return 0;
+}
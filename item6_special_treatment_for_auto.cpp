@@ -1,6 +1,7 @@
 #include <iostream>
 #include <vector>
 #include "type_name.hpp"
+#include "item6_feature_bitset.h"
 
 using namespace std;
 
@@ -9,17 +10,18 @@ class Widget{
 
 };
 
-// class Widget that return the vector<bool> in
+// class Widget that keeps its features in
 // the widget.
 class Widget_{
     public:
         Widget_():v({true, false}){};
-        vector<bool> v;
+        feature_bitset v;
 };
 
-// the _features_ function return the variable from 
-// class object v;
-std::vector<bool> _features_(const Widget_& w){
+// the _features_ function returns a view of the
+// class object v: no copy, no allocation. The view
+// must not outlive w_ (checked when NDEBUG is off).
+feature_view _features_(const Widget_& w){
     return w.v;
 }
 
@@ -28,6 +30,14 @@ std::vector<bool> features(const Widget& w){
     return v;
 }
 
+// The same features as a feature_bitset. A function cannot be overloaded on its
+// return type alone, so this one lives in its own namespace.
+namespace packed{
+feature_bitset features(const Widget&){
+    return {true, false};
+}
+}
+
 auto _features(const Widget& w){
     vector<bool> v{true, false};
     auto r = v[0];
@@ -82,12 +92,24 @@ int main(){
     cout << "_c : " << _c << endl;
     //cout << "*ptr : " << (char *)ptr;
 
+    // feature_bitset: operator[] on the returned temporary gives a plain bool,
+    // so auto deduces bool and there is nothing left to dangle.
+    auto pb = packed::features(w)[0];
+    cout << "pb's type : " << type_name<decltype(pb)>() << ", value : " << pb << endl;
+    // On a named bitset operator[] gives the explicit proxy; get() reads the bit.
+    feature_bitset flags = packed::features(w);
+    auto r = flags[0];
+    cout << "r's type : " << type_name<decltype(r)>() << endl;
+    r = false;
+    cout << "After r = false, flags[0] : " << flags.get(0) << ", r.get() : " << r.get() << endl;
+
     // Widget_ class
     Widget_ w_;
     auto x = _features_(w_)[0];
     cout << "w_.v[0]'s value : " << x << endl;
-    // Reassign the variable pointed to a temp variable.
-    // Which i mean that the 
+    cout << "x's type : " << type_name<decltype(x)>() << endl;
+    // x is a bool copied out of the view, so reassigning
+    // it leaves w_.v alone.
     x = false;
     cout << "After assignment, the w_.v[0] :" << _features_(w_)[0] << endl;
     cout << "x's value : " << x << endl;
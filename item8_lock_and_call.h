@@ -0,0 +1,146 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+/*
+    item8's lockAndCall: lock a mutex, call func(ptr), unlock. PtrType is deduced from the argument, so
+    passing 0 or NULL deduces an integer that func cannot take, while nullptr deduces std::nullptr_t,
+    which converts to any pointer type. Every overload below keeps that deduction.
+
+    The family:
+        lockAndCall(func, m, ptr)           any Lockable m: std::mutex, AdaptiveMutex, ...
+        lockAndCall(func, stripes, ptr)     locks the stripe of a StripedMutex chosen by hashing ptr
+        lockAndCallShared(func, m, ptr)     shared (reader) lock on a std::shared_mutex or a striped one
+    lockAndCall on a std::shared_mutex, or on a StripedMutex<std::shared_mutex>, takes the exclusive lock.
+*/
+
+// Use template to test
+template<typename FuncType, typename MuxType, typename PtrType>
+auto lockAndCall(FuncType func, MuxType& mutex, PtrType ptr) ->decltype(func(ptr))
+{
+    using MuxGuard = std::lock_guard<MuxType>;
+    MuxGuard g(mutex);
+    return func(ptr);
+}
+
+template<typename FuncType, typename PtrType>
+auto lockAndCallShared(FuncType func, std::shared_mutex& mutex, PtrType ptr) ->decltype(func(ptr))
+{
+    std::shared_lock<std::shared_mutex> g(mutex);
+    return func(ptr);
+}
+
+/* The address an argument of lockAndCall stands for: nullptr, raw and smart pointers all work. */
+inline const void* stripeKey(std::nullptr_t) noexcept { return nullptr; }
+template<typename T>
+const void* stripeKey(T* p) noexcept { return p; }
+template<typename T>
+const void* stripeKey(const std::shared_ptr<T>& p) noexcept { return p.get(); }
+template<typename T, typename D>
+const void* stripeKey(const std::unique_ptr<T, D>& p) noexcept { return p.get(); }
+
+/*
+    Stripes mutexes, one per cache line so that threads locking neighbouring stripes do not share a line.
+    Objects are spread over the stripes by a Fibonacci hash of their address; two objects may share a
+    stripe, so never hold two stripes at once without a global lock order (lock by stripe index).
+*/
+template<typename Mutex = std::mutex, std::size_t Stripes = 64>
+class StripedMutex{
+    static_assert(Stripes > 0 && (Stripes & (Stripes - 1)) == 0, "the stripe count must be a power of two");
+
+public:
+    static constexpr std::size_t stripes = Stripes;
+
+    static std::size_t stripeOf(const void* p) noexcept{
+        if constexpr(Stripes == 1){
+            (void)p;
+            return 0;
+        }else{
+            /* the low bits of an address are alignment, the multiply spreads the rest over the top bits */
+            auto v = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(p)) >> 4;
+            return static_cast<std::size_t>((v * 0x9E3779B97F4A7C15ULL) >> (64 - shift()));
+        }
+    }
+
+    Mutex& mutexFor(const void* p) noexcept { return slots[stripeOf(p)].m; }
+    Mutex& stripe(std::size_t i) noexcept { return slots[i].m; }
+
+private:
+    static constexpr unsigned shift() noexcept{
+        unsigned bits = 0;
+        while((std::size_t{1} << bits) < Stripes) ++bits;
+        return bits;
+    }
+
+    struct alignas(64) Slot{
+        Mutex m;
+    };
+    Slot slots[Stripes];
+};
+
+template<typename FuncType, typename Mutex, std::size_t Stripes, typename PtrType>
+auto lockAndCall(FuncType func, StripedMutex<Mutex, Stripes>& stripes, PtrType ptr) ->decltype(func(ptr))
+{
+    std::lock_guard<Mutex> g(stripes.mutexFor(stripeKey(ptr)));
+    return func(ptr);
+}
+
+template<typename FuncType, std::size_t Stripes, typename PtrType>
+auto lockAndCallShared(FuncType func, StripedMutex<std::shared_mutex, Stripes>& stripes, PtrType ptr) ->decltype(func(ptr))
+{
+    std::shared_lock<std::shared_mutex> g(stripes.mutexFor(stripeKey(ptr)));
+    return func(ptr);
+}
+
+/*
+    Spin, then block. Critical sections behind lockAndCall are usually short, and a waiter that parks in
+    the kernel pays a context switch each way; spinning a little first catches the holder on its way out.
+    How long to spin adapts, as a running average like glibc's adaptive mutex keeps: the budget drifts
+    towards twice the spins a successful acquisition needed, and down to minSpins when spinning did not
+    help, so a lock that is held for long stops burning cycles while one that is released quickly keeps
+    being caught by spinning.
+*/
+class AdaptiveMutex{
+public:
+    static constexpr int minSpins = 16;
+    static constexpr int maxSpins = 2000;
+
+    void lock(){
+        if(m.try_lock()) return; // uncontended fast path
+        int budget = spinBudget.load(std::memory_order_relaxed);
+        for(int i = 1; i <= budget; i++){
+            pause();
+            if(m.try_lock()){
+                adapt(budget, 2 * i);
+                return;
+            }
+        }
+        adapt(budget, minSpins);
+        m.lock();
+    }
+    bool try_lock() { return m.try_lock(); }
+    void unlock() { m.unlock(); }
+
+    int spinLimit() const noexcept { return spinBudget.load(std::memory_order_relaxed); }
+
+private:
+    static void pause() noexcept{
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    }
+
+    /* move a eighth of the way towards the spins that were needed (a racy update is harmless) */
+    void adapt(int budget, int needed) noexcept{
+        int next = budget + (needed - budget) / 8;
+        next = next < minSpins ? minSpins : next > maxSpins ? maxSpins : next;
+        spinBudget.store(next, std::memory_order_relaxed);
+    }
+
+    std::mutex m;
+    std::atomic<int> spinBudget{100};
+};
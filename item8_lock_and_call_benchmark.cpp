@@ -0,0 +1,119 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+#include "item8_lock_and_call.h"
+
+using namespace std;
+
+/*
+    Threads updating shared accounts through the lockAndCall family: one mutex for everything against
+    stripes chosen by the account's address, std::mutex against AdaptiveMutex, and a read-mostly mix
+    through lockAndCallShared. The final balance must equal the number of deposits in every run.
+
+    Usage : ./item8_lock_and_call_benchmark [threads] [operations per thread]
+*/
+
+using Clock = std::chrono::steady_clock;
+
+struct Account{
+    long balance = 0;
+};
+
+constexpr size_t accountCount = 4096;
+
+long deposit(Account* a){
+    return ++a->balance;
+}
+long readBalance(Account* a){
+    return a->balance;
+}
+
+/* run threads that each apply op(account, isWrite) opsPerThread times; returns ns per operation */
+template<typename Op>
+double run(unsigned threads, long opsPerThread, int writePercent, vector<Account>& accounts, Op op){
+    for(auto& a : accounts) a.balance = 0;
+    vector<std::thread> pool;
+    auto start = Clock::now();
+    for(unsigned t = 0; t < threads; t++){
+        pool.emplace_back([&accounts, &op, t, opsPerThread, writePercent]{
+            mt19937 gen(t);
+            uniform_int_distribution<size_t> pick(0, accounts.size() - 1);
+            uniform_int_distribution<int> percent(0, 99);
+            long sink = 0;
+            for(long i = 0; i < opsPerThread; i++){
+                sink += op(&accounts[pick(gen)], percent(gen) < writePercent);
+            }
+            if(sink < 0) cout << sink;
+        });
+    }
+    for(auto& th : pool) th.join();
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / (double(threads) * opsPerThread);
+}
+
+long total(const vector<Account>& accounts){
+    long sum = 0;
+    for(auto& a : accounts) sum += a.balance;
+    return sum;
+}
+
+int main(int argc, char* argv[]){
+    unsigned threads = argc > 1 ? unsigned(atoi(argv[1])) : std::max(4u, std::thread::hardware_concurrency());
+    long ops = argc > 2 ? atol(argv[2]) : 500000;
+    vector<Account> accounts(accountCount);
+
+    cout << threads << " threads x " << ops << " operations on " << accountCount << " accounts ("
+         << std::thread::hardware_concurrency() << " hardware threads)" << endl;
+    cout << fixed << setprecision(1);
+    bool ok = true;
+    auto row = [&](const char* name, double ns, long expectedWrites){
+        long sum = total(accounts);
+        bool good = expectedWrites < 0 || sum == expectedWrites;
+        ok = ok && good;
+        cout << "  " << left << setw(36) << name << right << setw(8) << ns << " ns/op" << (good ? "" : "   LOST UPDATES") << endl;
+    };
+    long allWrites = long(threads) * ops;
+
+    cout << "deposits only" << endl;
+    {
+        std::mutex m;
+        row("one std::mutex", run(threads, ops, 100, accounts, [&m](Account* a, bool){ return lockAndCall(deposit, m, a); }), allWrites);
+    }
+    {
+        AdaptiveMutex m;
+        row("one AdaptiveMutex", run(threads, ops, 100, accounts, [&m](Account* a, bool){ return lockAndCall(deposit, m, a); }), allWrites);
+    }
+    {
+        StripedMutex<std::mutex, 64> stripes;
+        row("64 std::mutex stripes", run(threads, ops, 100, accounts, [&stripes](Account* a, bool){ return lockAndCall(deposit, stripes, a); }), allWrites);
+    }
+    {
+        StripedMutex<AdaptiveMutex, 64> stripes;
+        row("64 AdaptiveMutex stripes", run(threads, ops, 100, accounts, [&stripes](Account* a, bool){ return lockAndCall(deposit, stripes, a); }), allWrites);
+    }
+
+    /* 10% deposits: the write count varies with the random mix, so only stripes vs one lock is compared */
+    cout << "90% reads, 10% deposits" << endl;
+    {
+        std::mutex m;
+        row("one std::mutex", run(threads, ops, 10, accounts, [&m](Account* a, bool write){
+            return write ? lockAndCall(deposit, m, a) : lockAndCall(readBalance, m, a);
+        }), -1);
+    }
+    {
+        std::shared_mutex m;
+        row("one std::shared_mutex", run(threads, ops, 10, accounts, [&m](Account* a, bool write){
+            return write ? lockAndCall(deposit, m, a) : lockAndCallShared(readBalance, m, a);
+        }), -1);
+    }
+    {
+        StripedMutex<std::shared_mutex, 64> stripes;
+        row("64 std::shared_mutex stripes", run(threads, ops, 10, accounts, [&stripes](Account* a, bool write){
+            return write ? lockAndCall(deposit, stripes, a) : lockAndCallShared(readBalance, stripes, a);
+        }), -1);
+    }
+    return ok ? 0 : 1;
+}
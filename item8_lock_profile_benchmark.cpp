@@ -0,0 +1,85 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+#include "item8_lock_and_call.h"
+#include "item8_profiled_mutex.h"
+
+using namespace std;
+
+/*
+    Finding the lock behind tail latency with ProfiledMutex.
+
+    Worker threads go through lockAndCall on three locks: "config" is read rarely and briefly, "cache"
+    often and briefly, and "journal" now and then with a slow critical section. A LockProfileReporter
+    prints the table every 250 ms; "journal" should stand out in hold time and, through it, in the wait
+    time of everyone queued behind it.
+
+    Before that, the cost of the instrumentation itself: uncontended lockAndCall on a std::mutex against
+    a ProfiledMutex.
+
+    Usage : ./item8_lock_profile_benchmark [threads] [seconds]
+*/
+
+using Clock = std::chrono::steady_clock;
+
+long touch(long* counter){
+    return ++*counter;
+}
+
+long slowAppend(long* counter){
+    volatile long spin = 0;
+    for(int i = 0; i < 20000; i++) spin = spin + i;
+    return ++*counter;
+}
+
+template<typename Mutex>
+double uncontendedNs(Mutex& m, long rounds){
+    long counter = 0;
+    auto start = Clock::now();
+    for(long i = 0; i < rounds; i++) lockAndCall(touch, m, &counter);
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / rounds;
+}
+
+int main(int argc, char* argv[]){
+    unsigned threads = argc > 1 ? unsigned(atoi(argv[1])) : 4;
+    int seconds = argc > 2 ? atoi(argv[2]) : 1;
+
+    {
+        const long rounds = 2000000;
+        std::mutex plain;
+        ProfiledMutex<> profiled("overhead");
+        cout << fixed << setprecision(1);
+        cout << "uncontended lockAndCall : std::mutex " << uncontendedNs(plain, rounds)
+             << " ns, ProfiledMutex " << uncontendedNs(profiled, rounds) << " ns" << endl << endl;
+    }
+
+    ProfiledMutex<> config("config"), cache("cache"), journal("journal");
+    long configValue = 0, cacheValue = 0, journalValue = 0;
+    std::atomic<bool> stop{false};
+    {
+        LockProfileReporter reporter(std::chrono::milliseconds(250));
+        vector<std::thread> workers;
+        for(unsigned t = 0; t < threads; t++){
+            workers.emplace_back([&, t]{
+                mt19937 gen(t);
+                uniform_int_distribution<int> percent(0, 99);
+                while(!stop.load(std::memory_order_relaxed)){
+                    int p = percent(gen);
+                    if(p < 5) lockAndCall(touch, config, &configValue);
+                    else if(p < 97) lockAndCall(touch, cache, &cacheValue);
+                    else lockAndCall(slowAppend, journal, &journalValue);
+                }
+            });
+        }
+        std::this_thread::sleep_for(std::chrono::seconds(seconds));
+        stop = true;
+        for(auto& w : workers) w.join();
+    }
+    cout << endl << "final" << endl;
+    printLockProfile();
+    return 0;
+}
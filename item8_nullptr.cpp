@@ -1,6 +1,7 @@
 #include <iostream>
 #include <memory>
 #include <mutex>
+#include "item8_lock_and_call.h"
 
 using namespace std;
 
@@ -20,15 +21,6 @@ int f2(std::unique_ptr<Widget> upw) {cout << "Invoke unique_ptr<Widget> " << end
 int f3(Widget * pw) {cout << "Invoke f3(Widget *pw) " << endl; return 0;}
 
 
-using MuxGuard = std::lock_guard<std::mutex>;
-// Use template to test
-template<typename FuncType, typename MuxType, typename PtrType>
-auto lockAndCall(FuncType func, MuxType& mutex, PtrType ptr) ->decltype(func(ptr))
-{
-    MuxGuard g(mutex);
-    return func(ptr);
-}
-
 int main(){
     std::mutex f1m, f2m, f3m;         // mutexes for f1, f2, and f3
     // tempalte dedunction.
@@ -37,6 +29,9 @@ int main(){
     // auto result1_t = lockAndCall(f1, f1m, 0);
     // auto result2_t = lockAndCall(f2, f2m, NULL);
     auto result3_t = lockAndCall(f3, f3m, nullptr);
+    // nullptr deduces the same way when the mutex is picked from stripes by hashing the pointer.
+    StripedMutex<> widgetStripes;
+    lockAndCall(f3, widgetStripes, nullptr);
 
     auto result = f1(0);
     auto result1 = f2(NULL);
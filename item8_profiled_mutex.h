@@ -0,0 +1,211 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+    Lock contention profiling for mutexes used through lockAndCall (item8_lock_and_call.h).
+
+    ProfiledMutex wraps a mutex and, for every acquisition, records how long the caller waited, how long
+    it held the lock, and whether it had to wait at all. The numbers go into lock-free histograms, so
+    recording never takes a lock of its own. It is Lockable, so it drops into the existing call sites:
+
+        ProfiledMutex<> f1m("f1m");
+        lockAndCall(f1, f1m, nullptr);
+
+    Every ProfiledMutex registers itself by name; printLockProfile() prints all of them, and a
+    LockProfileReporter prints them periodically from a background thread.
+*/
+
+/*
+    Power-of-two latency buckets: bucket 0 counts 0 ns, bucket i counts [2^(i-1), 2^i) ns. Percentiles are
+    reported as the upper bound of their bucket, so they are exact to within a factor of two.
+*/
+class LatencyHistogram{
+public:
+    static constexpr std::size_t bucketCount = 64;
+
+    void record(std::uint64_t ns) noexcept{
+        buckets[bucketOf(ns)].fetch_add(1, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+        total.fetch_add(ns, std::memory_order_relaxed);
+        std::uint64_t seen = maximum.load(std::memory_order_relaxed);
+        while(ns > seen && !maximum.compare_exchange_weak(seen, ns, std::memory_order_relaxed)){}
+    }
+
+    std::uint64_t samples() const noexcept { return count.load(std::memory_order_relaxed); }
+    std::uint64_t max() const noexcept { return maximum.load(std::memory_order_relaxed); }
+    double mean() const noexcept{
+        auto n = samples();
+        return n ? double(total.load(std::memory_order_relaxed)) / n : 0.0;
+    }
+
+    /* upper bound, in ns, of the bucket holding the p-th percentile (0 < p <= 100) */
+    std::uint64_t percentile(double p) const noexcept{
+        std::uint64_t counts[bucketCount], n = 0;
+        for(std::size_t i = 0; i < bucketCount; i++) n += counts[i] = buckets[i].load(std::memory_order_relaxed);
+        if(n == 0) return 0;
+        auto rank = static_cast<std::uint64_t>(p / 100.0 * double(n) + 0.5);
+        rank = std::max<std::uint64_t>(rank, 1);
+        std::uint64_t seen = 0;
+        for(std::size_t i = 0; i < bucketCount; i++){
+            seen += counts[i];
+            if(seen >= rank) return i == 0 ? 0 : std::min(max(), (std::uint64_t{1} << i) - 1);
+        }
+        return max();
+    }
+
+private:
+    static std::size_t bucketOf(std::uint64_t ns) noexcept{
+        return ns == 0 ? 0 : std::min<std::size_t>(64 - static_cast<std::size_t>(__builtin_clzll(ns)), bucketCount - 1);
+    }
+
+    std::atomic<std::uint64_t> buckets[bucketCount] = {};
+    std::atomic<std::uint64_t> count{0};
+    std::atomic<std::uint64_t> total{0};
+    std::atomic<std::uint64_t> maximum{0};
+};
+
+struct LockProfile{
+    std::string name;
+    LatencyHistogram wait;
+    LatencyHistogram hold;
+    std::atomic<std::uint64_t> contended{0};
+};
+
+/* All live profiles by name. Registration is rare (construction and destruction of a mutex). */
+class LockProfileRegistry{
+public:
+    static LockProfileRegistry& instance(){
+        static LockProfileRegistry registry;
+        return registry;
+    }
+
+    void add(const LockProfile* p){
+        std::lock_guard<std::mutex> g(m);
+        profiles.push_back(p);
+    }
+    void remove(const LockProfile* p){
+        std::lock_guard<std::mutex> g(m);
+        profiles.erase(std::remove(profiles.begin(), profiles.end(), p), profiles.end());
+    }
+
+    void print(std::ostream& os){
+        std::ostringstream out;
+        out << std::left << std::setw(16) << "lock" << std::right << std::setw(12) << "acquired"
+            << std::setw(11) << "contended" << std::setw(12) << "wait p50" << std::setw(12) << "wait p99"
+            << std::setw(12) << "wait max" << std::setw(12) << "hold p50" << std::setw(12) << "hold p99"
+            << std::setw(12) << "hold max" << "   (ns)\n";
+        std::lock_guard<std::mutex> g(m);
+        for(auto p : profiles){
+            auto n = p->hold.samples();
+            double pct = n ? 100.0 * double(p->contended.load(std::memory_order_relaxed)) / double(n) : 0.0;
+            std::ostringstream contended;
+            contended << std::fixed << std::setprecision(1) << pct << '%';
+            out << std::left << std::setw(16) << p->name << std::right << std::setw(12) << n
+                << std::setw(11) << contended.str()
+                << std::setw(12) << p->wait.percentile(50) << std::setw(12) << p->wait.percentile(99)
+                << std::setw(12) << p->wait.max() << std::setw(12) << p->hold.percentile(50)
+                << std::setw(12) << p->hold.percentile(99) << std::setw(12) << p->hold.max() << '\n';
+        }
+        os << out.str() << std::flush;
+    }
+
+private:
+    std::mutex m;
+    std::vector<const LockProfile*> profiles;
+};
+
+inline void printLockProfile(std::ostream& os = std::cout){
+    LockProfileRegistry::instance().print(os);
+}
+
+template<typename Mutex = std::mutex>
+class ProfiledMutex{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit ProfiledMutex(std::string name){
+        profile.name = std::move(name);
+        LockProfileRegistry::instance().add(&profile);
+    }
+    ~ProfiledMutex(){
+        LockProfileRegistry::instance().remove(&profile);
+    }
+    ProfiledMutex(const ProfiledMutex&) = delete;
+    ProfiledMutex& operator=(const ProfiledMutex&) = delete;
+
+    void lock(){
+        if(m.try_lock()){
+            profile.wait.record(0);
+        }else{
+            auto start = Clock::now();
+            m.lock();
+            profile.contended.fetch_add(1, std::memory_order_relaxed);
+            profile.wait.record(elapsedNs(start, Clock::now()));
+        }
+        acquired = Clock::now();
+    }
+    bool try_lock(){
+        if(!m.try_lock()) return false;
+        profile.wait.record(0);
+        acquired = Clock::now();
+        return true;
+    }
+    void unlock(){
+        /* acquired is only touched by the holder, so reading it here needs no synchronization */
+        profile.hold.record(elapsedNs(acquired, Clock::now()));
+        m.unlock();
+    }
+
+    const LockProfile& stats() const noexcept { return profile; }
+
+private:
+    static std::uint64_t elapsedNs(Clock::time_point from, Clock::time_point to) noexcept{
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count());
+    }
+
+    Mutex m;
+    Clock::time_point acquired;
+    LockProfile profile;
+};
+
+/* Prints every registered lock's profile each period until it is destroyed. */
+class LockProfileReporter{
+public:
+    explicit LockProfileReporter(std::chrono::milliseconds period, std::ostream& os = std::cout)
+        :t([this, period, &os]{
+            std::unique_lock<std::mutex> lk(m);
+            while(!cv.wait_for(lk, period, [this]{ return stopping; })){
+                lk.unlock();
+                printLockProfile(os);
+                lk.lock();
+            }
+        }){}
+    ~LockProfileReporter(){
+        {
+            std::lock_guard<std::mutex> g(m);
+            stopping = true;
+        }
+        cv.notify_one();
+        t.join();
+    }
+    LockProfileReporter(const LockProfileReporter&) = delete;
+    LockProfileReporter& operator=(const LockProfileReporter&) = delete;
+
+private:
+    std::mutex m;
+    std::condition_variable cv;
+    bool stopping = false;
+    std::thread t; // last, so it starts after the members it uses (item37)
+};
@@ -0,0 +1,176 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include <optional>
+#include <sstream>
+#include "item17_string_table.h"
+#include "item22_widget.h"
+#include "item23_annotation.h"
+#include "item25_widget.h"
+
+using namespace std;
+
+/*
+    Guard against moves that silently fall back to copies.
+
+    item17 records how declaring ~StringTable() turned st1 = std::move(st) into a copy of 10M entries:
+    the move request compiled fine, it just bound to the copy operation. Nothing but the run time shows it.
+
+    For every type below we build a small and a large object and time move construction and move
+    assignment on both, next to a copy of the large one. A real move of a node-based or heap-backed
+    container only swaps pointers, so its cost must not grow with the size of the object. If the large
+    move costs noticeably more than the small one, the move is not O(1) and the program exits with 1.
+
+    Some of these types print from their special member functions; cout is muted while timing.
+*/
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t smallSize = 1000;
+constexpr size_t largeSize = 200000;
+constexpr int moveRounds = 200;
+constexpr int copyRounds = 3;
+
+class NullBuffer : public std::streambuf{
+protected:
+    int overflow(int c) override { return c; }
+};
+
+/*
+    Median of a few repetitions, in nanoseconds per operation. A single trial run caps the rounds so that
+    a move which has regressed into a copy of 200k elements fails in seconds rather than minutes.
+ */
+template<typename F>
+double nsPerOp(int rounds, F op){
+    auto trialStart = Clock::now();
+    op();
+    double trial = std::chrono::duration<double, std::nano>(Clock::now() - trialStart).count();
+    rounds = std::max(1, std::min(rounds, int(2e6 / std::max(trial, 1.0))));
+
+    vector<double> samples;
+    for(int rep = 0; rep < 5; rep++){
+        auto start = Clock::now();
+        for(int i = 0; i < rounds; i++) op();
+        samples.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count() / rounds);
+    }
+    std::nth_element(samples.begin(), samples.begin() + 2, samples.end());
+    return samples[2];
+}
+
+struct MoveReport{
+    double moveCtorSmall = 0, moveCtorLarge = 0;
+    double moveAssignSmall = -1, moveAssignLarge = -1;
+    double copyLarge = -1;
+};
+
+template<typename T, typename Make>
+MoveReport measure(Make make){
+    MoveReport r;
+    std::optional<T> small(make(smallSize));
+    std::optional<T> large(make(largeSize));
+
+    /* move out and back in, so the object under test is never left moved-from */
+    auto moveCtor = [](std::optional<T>& obj){
+        return [&obj]{
+            std::optional<T> tmp(std::in_place, std::move(*obj));
+            obj.reset();
+            obj.emplace(std::move(*tmp));
+        };
+    };
+    r.moveCtorSmall = nsPerOp(moveRounds, moveCtor(small));
+    r.moveCtorLarge = nsPerOp(moveRounds, moveCtor(large));
+
+    if constexpr(std::is_move_assignable<T>::value){
+        T other = make(0);
+        auto moveAssign = [&other](std::optional<T>& obj){
+            return [&obj, &other]{
+                other = std::move(*obj);
+                *obj = std::move(other);
+            };
+        };
+        r.moveAssignSmall = nsPerOp(moveRounds, moveAssign(small));
+        r.moveAssignLarge = nsPerOp(moveRounds, moveAssign(large));
+    }
+    if constexpr(std::is_copy_constructible<T>::value){
+        r.copyLarge = nsPerOp(copyRounds, [&large]{ T copy(*large); });
+    }
+    return r;
+}
+
+/* Allow a large object 4x the cost of a small one plus some noise, a copy of it costs ~200x. */
+bool constantTime(double small, double large){
+    return small < 0 || large <= 4 * small + 500;
+}
+
+bool report(const string& name, const MoveReport& r){
+    bool ok = constantTime(r.moveCtorSmall, r.moveCtorLarge) && constantTime(r.moveAssignSmall, r.moveAssignLarge);
+    auto cell = [](double ns){
+        ostringstream os;
+        if(ns < 0) os << "n/a";
+        else os << fixed << setprecision(0) << ns;
+        return os.str();
+    };
+    cout << left << setw(22) << name << right
+         << setw(12) << cell(r.moveCtorSmall) << setw(12) << cell(r.moveCtorLarge)
+         << setw(12) << cell(r.moveAssignSmall) << setw(12) << cell(r.moveAssignLarge)
+         << setw(14) << cell(r.copyLarge)
+         << "   " << (ok ? "ok" : "FAIL: move is not O(1)") << endl;
+    return ok;
+}
+
+int main(){
+    std::streambuf* out = cout.rdbuf();
+    NullBuffer null;
+    vector<pair<string, MoveReport>> results;
+    auto run = [&](const string& name, MoveReport r){ results.emplace_back(name, r); };
+
+    cout.rdbuf(&null);
+    run("StringTable", measure<StringTable>([](size_t n){
+        StringTable t;
+        for(size_t i = 0; i < n; i++) t.setValue(make_pair(int(i), "abc"));
+        return t;
+    }));
+    run("ArenaStringTable", measure<ArenaStringTable>([](size_t n){
+        ArenaStringTable t;
+        for(size_t i = 0; i < n; i++) t.setValue(make_pair(int(i), to_string(i)));
+        return t;
+    }));
+    run("item22 Widget", measure<Widget>([](size_t n){
+        Widget w;
+        for(size_t i = 0; i < n; i++) w.addData(double(i));
+        return w;
+    }));
+    run("item22 FastWidget", measure<FastWidget>([](size_t n){
+        FastWidget w;
+        for(size_t i = 0; i < n; i++) w.addData(double(i));
+        return w;
+    }));
+    run("item22 CowWidget", measure<CowWidget>([](size_t n){
+        CowWidget w;
+        for(size_t i = 0; i < n; i++) w.addData(double(i));
+        return w;
+    }));
+    run("item25 Widget", measure<item25::Widget>([](size_t n){
+        string name(n * 8, 'w');
+        return item25::Widget(name);
+    }));
+    run("item23 Annotation", measure<Annotation>([](size_t n){
+        return Annotation(string(n * 8, 'a'));
+    }));
+    cout.rdbuf(out);
+
+    cout << "ns per operation, small = " << smallSize << " elements, large = " << largeSize << " elements" << endl;
+    cout << left << setw(22) << "type" << right
+         << setw(12) << "mctor small" << setw(12) << "mctor large"
+         << setw(12) << "massn small" << setw(12) << "massn large"
+         << setw(14) << "copy large" << endl;
+    bool ok = true;
+    for(auto& r : results){
+        ok = report(r.first, r.second) && ok;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,213 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/*
+    Person/Person1 link partners through std::shared_ptr/std::weak_ptr, so every getPartner() pays for a
+    lock() (an atomic increment and decrement on the control block). PersonGraph keeps the same "partner"
+    relation, but the people live in an arena owned by the graph and the edges are plain 32-bit indices,
+    so walking partner links never touches a reference count.
+
+    The dangling detection weak_ptr gives us is kept by handles: a PersonHandle is (index, generation),
+    and destroying a person bumps the generation of its slot. An old handle to a recycled slot no longer
+    matches and is reported as expired, just like weak_ptr::expired().
+
+    Storage is structure-of-arrays: traversal only reads m_partner, the names stay out of the cache.
+*/
+struct PersonHandle {
+    std::uint32_t index;
+    std::uint32_t generation;
+};
+
+inline bool operator==(PersonHandle lhs, PersonHandle rhs) noexcept {
+    return lhs.index == rhs.index && lhs.generation == rhs.generation;
+}
+inline bool operator!=(PersonHandle lhs, PersonHandle rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+/* Outcome of a bulk partnerUp: nothing is printed on the hot path, callers get the counts. */
+struct PartnerUpResult {
+    std::size_t linked = 0;
+    std::size_t failed = 0;
+};
+
+class PersonGraph {
+public:
+    using Index = std::uint32_t;
+    static constexpr Index npos = std::numeric_limits<Index>::max();
+    static constexpr PersonHandle null{npos, 0};
+
+    PersonGraph() = default;
+    explicit PersonGraph(std::size_t capacity) { reserve(capacity); }
+
+    void reserve(std::size_t capacity) {
+        m_name.reserve(capacity);
+        m_partner.reserve(capacity);
+        m_generation.reserve(capacity);
+    }
+
+    PersonHandle create(std::string name) {
+        Index index;
+        if (!m_free.empty()) {
+            index = m_free.back();
+            m_free.pop_back();
+            m_name[index] = std::move(name);
+        } else {
+            index = static_cast<Index>(m_name.size());
+            m_name.push_back(std::move(name));
+            m_partner.push_back(npos);
+            m_generation.push_back(0);
+        }
+        ++m_live;
+        return {index, m_generation[index]};
+    }
+
+    /* Destroying a person also breaks the partner's link, so no index edge ever dangles. */
+    bool destroy(PersonHandle h) {
+        if (!alive(h))
+            return false;
+        Index partner = m_partner[h.index];
+        if (partner != npos)
+            m_partner[partner] = npos;
+        m_partner[h.index] = npos;
+        m_name[h.index].clear();
+        ++m_generation[h.index];
+        m_free.push_back(h.index);
+        --m_live;
+        return true;
+    }
+
+    bool alive(PersonHandle h) const noexcept {
+        return h.index < m_generation.size() && m_generation[h.index] == h.generation;
+    }
+    bool expired(PersonHandle h) const noexcept { return !alive(h); }
+
+    /* Same contract as the shared_ptr version: both must be valid, old partners are replaced. */
+    friend bool partnerUp(PersonGraph& g, PersonHandle p1, PersonHandle p2) {
+        if (!g.alive(p1) || !g.alive(p2) || p1.index == p2.index)
+            return false;
+        g.unlink(p1.index);
+        g.unlink(p2.index);
+        g.m_partner[p1.index] = p2.index;
+        g.m_partner[p2.index] = p1.index;
+        return true;
+    }
+
+    /*
+        Bulk version for loading large graphs. Pairs are split across threads and each edge is inserted
+        under the striped locks of its two endpoints. Unlike the single-pair version, a pair whose people
+        already have partners fails instead of replacing them - otherwise the outcome would depend on the
+        thread schedule. Invalid handles and self-pairs fail too. No other member may run concurrently.
+    */
+    friend PartnerUpResult partnerUp(PersonGraph& g, const std::pair<PersonHandle, PersonHandle>* pairs,
+                                     std::size_t count, unsigned threads);
+
+    /* Handle to the partner, or PersonGraph::null - the counterpart of weak_ptr::lock() returning nullptr. */
+    PersonHandle getPartner(PersonHandle h) const noexcept {
+        if (!alive(h) || m_partner[h.index] == npos)
+            return null;
+        Index partner = m_partner[h.index];
+        return {partner, m_generation[partner]};
+    }
+
+    /* Unchecked traversal for hot loops: the caller already holds a live index. */
+    Index partnerOf(Index index) const noexcept { return m_partner[index]; }
+
+    /* Throws std::out_of_range for null or expired handles; nameOf is the unchecked version. */
+    const std::string& getName(PersonHandle h) const {
+        if (!alive(h))
+            throw std::out_of_range("PersonGraph::getName: expired handle");
+        return m_name[h.index];
+    }
+    const std::string& nameOf(Index index) const { return m_name[index]; }
+
+    std::size_t size() const noexcept { return m_live; }
+    std::size_t slots() const noexcept { return m_name.size(); }
+
+private:
+    void unlink(Index index) noexcept {
+        Index old = m_partner[index];
+        if (old != npos)
+            m_partner[old] = npos;
+        m_partner[index] = npos;
+    }
+
+    std::vector<std::string> m_name;
+    std::vector<Index> m_partner;
+    std::vector<std::uint32_t> m_generation;
+    std::vector<Index> m_free;
+    std::size_t m_live = 0;
+};
+
+inline PartnerUpResult partnerUp(PersonGraph& g, const std::pair<PersonHandle, PersonHandle>* pairs,
+                                 std::size_t count, unsigned threads = 0) {
+    constexpr std::size_t stripeCount = 256;
+    constexpr std::size_t minPairsPerThread = 1 << 14;
+    std::array<std::mutex, stripeCount> stripes;
+
+    auto insert = [&g, &stripes](const std::pair<PersonHandle, PersonHandle>* first,
+                                 const std::pair<PersonHandle, PersonHandle>* last) {
+        PartnerUpResult r;
+        for (; first != last; ++first) {
+            PersonHandle p1 = first->first, p2 = first->second;
+            if (!g.alive(p1) || !g.alive(p2) || p1.index == p2.index) {
+                ++r.failed;
+                continue;
+            }
+            std::size_t s1 = p1.index % stripeCount, s2 = p2.index % stripeCount;
+            if (s1 > s2)
+                std::swap(s1, s2);
+            std::unique_lock<std::mutex> l1(stripes[s1]);
+            std::unique_lock<std::mutex> l2;
+            if (s2 != s1)
+                l2 = std::unique_lock<std::mutex>(stripes[s2]);
+            if (g.m_partner[p1.index] != PersonGraph::npos || g.m_partner[p2.index] != PersonGraph::npos) {
+                ++r.failed;
+                continue;
+            }
+            g.m_partner[p1.index] = p2.index;
+            g.m_partner[p2.index] = p1.index;
+            ++r.linked;
+        }
+        return r;
+    };
+
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<std::size_t>(threads, count / minPairsPerThread + 1));
+    if (threads <= 1)
+        return insert(pairs, pairs + count);
+
+    std::vector<PartnerUpResult> results(threads);
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    std::size_t chunk = (count + threads - 1) / threads;
+    for (unsigned t = 1; t < threads; ++t) {
+        std::size_t begin = std::min(count, t * chunk), end = std::min(count, begin + chunk);
+        workers.emplace_back([&, t, begin, end] { results[t] = insert(pairs + begin, pairs + end); });
+    }
+    results[0] = insert(pairs, pairs + std::min(count, chunk));
+    for (auto& w : workers)
+        w.join();
+
+    PartnerUpResult total;
+    for (auto& r : results) {
+        total.linked += r.linked;
+        total.failed += r.failed;
+    }
+    return total;
+}
+
+inline PartnerUpResult partnerUp(PersonGraph& g, const std::vector<std::pair<PersonHandle, PersonHandle>>& pairs,
+                                 unsigned threads = 0) {
+    return partnerUp(g, pairs.data(), pairs.size(), threads);
+}
@@ -1,6 +1,9 @@
 #include <iostream>
 #include <memory> // for std::shared_ptr
 #include <string>
+#include <chrono>
+#include <vector>
+#include "item_person_graph.h"
 
 using namespace std; 
 class Person
@@ -92,5 +95,25 @@ int main()
     cout << "Weak_pointer's use_count, lucy1's partner(weak_pointer) : " << lucy1->m_partner.use_count() << endl;
     //cout << "Shared"
 
+    /* Loading a large graph: one bulk partnerUp instead of a cout per pair. */
+    const std::uint32_t n = 2000000;
+    PersonGraph graph(n);
+    std::vector<PersonHandle> people;
+    people.reserve(n);
+    for (std::uint32_t i = 0; i < n; ++i)
+        people.push_back(graph.create(""));
+    std::vector<std::pair<PersonHandle, PersonHandle>> pairs;
+    pairs.reserve(n / 2 + 2);
+    for (std::uint32_t i = 0; i + 1 < n; i += 2)
+        pairs.emplace_back(people[i], people[i + 1]);
+    pairs.emplace_back(people[0], people[0]);    // self-pair, rejected
+    pairs.emplace_back(people[0], people[2]);    // both already partnered, rejected
+
+    auto start = std::chrono::steady_clock::now();
+    auto result = partnerUp(graph, pairs);
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    cout << "Bulk partnerUp : " << result.linked << " linked, " << result.failed << " failed in "
+         << elapsed.count() << " ms" << endl;
+
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,243 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/*
+    A vector that keeps up to N elements inside the object and only goes to the heap beyond that.
+
+    Most of the short vectors in this project (two or three doubles, a handful of ints) never need the
+    heap at all with a small_vector. The trade-off is item29's std::array one: while the elements are
+    inline, a move has to move them one by one, so it is O(size) <= O(N). Once they are on the heap a
+    move just steals the pointer, like std::vector. Moves are noexcept whenever T's move is, so a
+    std::vector<small_vector<T, N>> relocates by moving.
+*/
+template<typename T, std::size_t N>
+class small_vector{
+    static_assert(N > 0, "small_vector needs an inline capacity of at least one element");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    static constexpr size_type inline_capacity = N;
+
+    small_vector() noexcept = default;
+
+    explicit small_vector(size_type count, const T& value = T()){
+        assign(count, value);
+    }
+
+    small_vector(std::initializer_list<T> init){
+        assign(init.begin(), init.end());
+    }
+
+    template<typename It, typename = typename std::iterator_traits<It>::iterator_category>
+    small_vector(It first, It last){
+        assign(first, last);
+    }
+
+    small_vector(const small_vector& rhs){
+        assign(rhs.begin(), rhs.end());
+    }
+
+    small_vector(small_vector&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value){
+        take(std::move(rhs));
+    }
+
+    small_vector& operator=(const small_vector& rhs){
+        if(this != &rhs) assign(rhs.begin(), rhs.end());
+        return *this;
+    }
+
+    small_vector& operator=(small_vector&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value){
+        if(this != &rhs){
+            clear();
+            release();
+            take(std::move(rhs));
+        }
+        return *this;
+    }
+
+    small_vector& operator=(std::initializer_list<T> init){
+        assign(init.begin(), init.end());
+        return *this;
+    }
+
+    ~small_vector(){
+        clear();
+        release();
+    }
+
+    void assign(size_type count, const T& value){
+        clear();
+        reserve(count);
+        for(; size_ < count; ++size_) ::new (static_cast<void*>(data_ + size_)) T(value);
+    }
+
+    template<typename It, typename = typename std::iterator_traits<It>::iterator_category>
+    void assign(It first, It last){
+        clear();
+        if constexpr(std::is_base_of<std::forward_iterator_tag,
+                                     typename std::iterator_traits<It>::iterator_category>::value){
+            reserve(static_cast<size_type>(std::distance(first, last)));
+        }
+        for(; first != last; ++first) emplace_back(*first);
+    }
+
+    iterator begin() noexcept { return data_; }
+    const_iterator begin() const noexcept { return data_; }
+    const_iterator cbegin() const noexcept { return data_; }
+    iterator end() noexcept { return data_ + size_; }
+    const_iterator end() const noexcept { return data_ + size_; }
+    const_iterator cend() const noexcept { return data_ + size_; }
+
+    size_type size() const noexcept { return size_; }
+    size_type capacity() const noexcept { return capacity_; }
+    bool empty() const noexcept { return size_ == 0; }
+    /* true while the elements live in the object itself */
+    bool is_inline() const noexcept { return data_ == inlineData(); }
+
+    T* data() noexcept { return data_; }
+    const T* data() const noexcept { return data_; }
+
+    T& operator[](size_type i) noexcept { return data_[i]; }
+    const T& operator[](size_type i) const noexcept { return data_[i]; }
+    T& at(size_type i){
+        if(i >= size_) throw std::out_of_range("small_vector::at");
+        return data_[i];
+    }
+    const T& at(size_type i) const{
+        if(i >= size_) throw std::out_of_range("small_vector::at");
+        return data_[i];
+    }
+    T& front() noexcept { return data_[0]; }
+    const T& front() const noexcept { return data_[0]; }
+    T& back() noexcept { return data_[size_ - 1]; }
+    const T& back() const noexcept { return data_[size_ - 1]; }
+
+    void reserve(size_type n){
+        if(n > capacity_) relocate(n);
+    }
+
+    void push_back(const T& value){ emplace_back(value); }
+    void push_back(T&& value){ emplace_back(std::move(value)); }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args){
+        if(size_ == capacity_){
+            /* construct first: args may refer to an element we are about to relocate */
+            T tmp(std::forward<Args>(args)...);
+            relocate(capacity_ * 2);
+            ::new (static_cast<void*>(data_ + size_)) T(std::move(tmp));
+        }else{
+            ::new (static_cast<void*>(data_ + size_)) T(std::forward<Args>(args)...);
+        }
+        return data_[size_++];
+    }
+
+    void pop_back() noexcept{
+        data_[--size_].~T();
+    }
+
+    void resize(size_type n){
+        if(n < size_){
+            std::destroy(data_ + n, data_ + size_);
+            size_ = n;
+            return;
+        }
+        reserve(n);
+        for(; size_ < n; ++size_) ::new (static_cast<void*>(data_ + size_)) T();
+    }
+
+    void clear() noexcept{
+        std::destroy(data_, data_ + size_);
+        size_ = 0;
+    }
+
+    friend bool operator==(const small_vector& lhs, const small_vector& rhs){
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+    friend bool operator!=(const small_vector& lhs, const small_vector& rhs){
+        return !(lhs == rhs);
+    }
+
+private:
+    T* inlineData() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+    const T* inlineData() const noexcept { return std::launder(reinterpret_cast<const T*>(storage)); }
+
+    /*
+        Heap storage comes from the plain operator new unless T is over-aligned, so a replaced global
+        operator new (like the allocation counter in item12_make_widget_benchmark) sees every spill.
+    */
+    static T* allocate(size_type n){
+        if constexpr(alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__){
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+        }else{
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+    }
+    static void deallocate(T* p) noexcept{
+        if constexpr(alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__){
+            ::operator delete(p, std::align_val_t(alignof(T)));
+        }else{
+            ::operator delete(p);
+        }
+    }
+
+    /* Move into new storage of capacity n; moves only if that cannot throw, like std::vector. */
+    void relocate(size_type n){
+        T* fresh = allocate(n);
+        size_type i = 0;
+        try{
+            for(; i < size_; ++i) ::new (static_cast<void*>(fresh + i)) T(std::move_if_noexcept(data_[i]));
+        }catch(...){
+            std::destroy(fresh, fresh + i);
+            deallocate(fresh);
+            throw;
+        }
+        std::destroy(data_, data_ + size_);
+        release();
+        data_ = fresh;
+        capacity_ = n;
+    }
+
+    /* Precondition: *this is empty and inline. */
+    void take(small_vector&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value){
+        if(!rhs.is_inline()){
+            data_ = rhs.data_;
+            size_ = rhs.size_;
+            capacity_ = rhs.capacity_;
+            rhs.data_ = rhs.inlineData();
+            rhs.size_ = 0;
+            rhs.capacity_ = N;
+            return;
+        }
+        for(; size_ < rhs.size_; ++size_) ::new (static_cast<void*>(data_ + size_)) T(std::move(rhs.data_[size_]));
+        rhs.clear();
+    }
+
+    void release() noexcept{
+        if(!is_inline()) deallocate(data_);
+        data_ = inlineData();
+        capacity_ = N;
+    }
+
+    alignas(T) unsigned char storage[N * sizeof(T)];
+    T* data_ = inlineData();
+    size_type size_ = 0;
+    size_type capacity_ = N;
+};
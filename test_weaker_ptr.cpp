@@ -1,6 +1,9 @@
 #include <iostream>
 #include <memory> // for std::shared_ptr and std::weak_ptr
 #include <string>
+#include <chrono>
+#include <vector>
+#include "item_person_graph.h"
  
 class Person
 {
@@ -46,6 +49,51 @@ int main()
  
 	auto partner = ricky->getPartner(); // get shared_ptr to Ricky's partner
 	std::cout << ricky->getName() << "'s partner is: " << partner->getName() << '\n';
- 
+
+	/* The same relation kept in a PersonGraph: handles instead of shared_ptr, indices instead of weak_ptr. */
+	PersonGraph g;
+	auto lucy1 = g.create("Lucy");
+	auto ricky1 = g.create("Ricky");
+	partnerUp(g, lucy1, ricky1);
+	std::cout << g.getName(ricky1) << "'s partner is: " << g.getName(g.getPartner(ricky1)) << '\n';
+	g.destroy(lucy1);
+	std::cout << "After destroying Lucy, Ricky's partner expired : " << g.expired(g.getPartner(ricky1))
+	          << ", Lucy's handle expired : " << g.expired(lucy1) << '\n';
+
+	/* Walk every partner link: lock() on weak_ptr vs. a plain index load. */
+	const std::uint32_t n = 1000000;
+	struct Node { std::weak_ptr<Node> m_partner; }; // Person without the chatty constructor
+	std::vector<std::shared_ptr<Node>> people;
+	people.reserve(n);
+	PersonGraph graph(n);
+	for (std::uint32_t i = 0; i < n; ++i) {
+		people.push_back(std::make_shared<Node>());
+		graph.create("");
+	}
+	for (std::uint32_t i = 0; i + 1 < n; i += 2) {
+		people[i]->m_partner = people[i + 1];
+		people[i + 1]->m_partner = people[i];
+		partnerUp(graph, {i, 0}, {i + 1, 0});
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	std::size_t linked = 0;
+	for (auto& p : people)
+		linked += p->m_partner.lock() != nullptr;
+	auto lockTime = std::chrono::steady_clock::now() - start;
+
+	start = std::chrono::steady_clock::now();
+	std::size_t linked1 = 0;
+	for (std::uint32_t i = 0; i < graph.slots(); ++i)
+		linked1 += graph.partnerOf(i) != PersonGraph::npos;
+	auto indexTime = std::chrono::steady_clock::now() - start;
+
+	using std::chrono::duration_cast;
+	using std::chrono::microseconds;
+	std::cout << "weak_ptr::lock() walk : " << linked << " links, "
+	          << duration_cast<microseconds>(lockTime).count() << " us\n";
+	std::cout << "PersonGraph index walk : " << linked1 << " links, "
+	          << duration_cast<microseconds>(indexTime).count() << " us\n";
+
 	return 0;
 }
\ No newline at end of file